@@ -18,19 +18,25 @@
 #include "../common/zmq_subscriber.hpp"
 #include "../common/student.hpp"
 #include "../common/serializer.hpp"
+#include "../common/student_delta.hpp"
 
 class StudentClient {
 private:
     std::atomic<bool> running_;
     ZmqSubscriber subscriber_;
     std::string server_endpoint_;
-    std::vector<Student> received_students_;
+    std::string snapshot_endpoint_;
+    std::string topic_;
+    // Списки тем хранит подписчик; здесь только вывод и счётчик обновлений
     std::mutex data_mutex_;
     int update_count_;
 
 public:
-    StudentClient(const std::string& endpoint = "tcp://localhost:5556")
-        : running_(false), server_endpoint_(endpoint), update_count_(0) {}
+    StudentClient(const std::string& endpoint = "tcp://localhost:5556",
+                  const std::string& snapshot_endpoint = "tcp://localhost:5555",
+                  const std::string& topic = "")
+        : running_(false), server_endpoint_(endpoint), snapshot_endpoint_(snapshot_endpoint),
+          topic_(topic), update_count_(0) {}
 
     ~StudentClient() {
         stop();
@@ -52,6 +58,11 @@ public:
             onStudentsReceived(students);
         });
 
+        // Изменения подписчик применяет к списку своей темы сам
+        subscriber_.setDeltaCallback([this](const StudentDelta& delta) {
+            onDeltaReceived(delta);
+        });
+
         subscriber_.setRawMessageCallback([this](const std::string& message) {
             onRawMessageReceived(message);
         });
@@ -60,7 +71,9 @@ public:
             onErrorReceived(error);
         });
 
-        if (!subscriber_.start(server_endpoint_)) {
+        // Текущие данные запрашиваются сразу, не дожидаясь изменений на сервере
+        // Префикс темы: сервер с разбиением присылает только подходящие шарды
+        if (!subscriber_.start(server_endpoint_, topic_, snapshot_endpoint_)) {
             std::cerr << "Ошибка подключения к серверу" << std::endl;
             return false;
         }
@@ -89,21 +102,22 @@ public:
     }
 
     void printCurrentData() {
+        // Общий список собирается из тем подписчика только для показа
+        std::vector<Student> students = subscriber_.getStudents();
         std::lock_guard<std::mutex> lock(data_mutex_);
         
-        if (received_students_.empty()) {
+        if (students.empty()) {
             std::cout << "Данные не получены" << std::endl;
             return;
         }
 
-        displayStudentsTable(received_students_);
+        displayStudentsTable(students);
     }
 
 private:
     void onStudentsReceived(const std::vector<Student>& students) {
         std::lock_guard<std::mutex> lock(data_mutex_);
         
-        received_students_ = students;
         update_count_++;
 
         std::cout << "Получено обновление #" << update_count_ << std::endl;
@@ -120,7 +134,27 @@ private:
         }
     }
 
+    void onDeltaReceived(const StudentDelta& delta) {
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        
+        update_count_++;
+
+        std::cout << "Получено изменение #" << update_count_ << " (версия " << delta.version << ")" << std::endl;
+        std::cout << "   Добавлено: " << delta.added.size()
+                  << ", удалено: " << delta.removed.size()
+                  << ", изменено: " << delta.modified.size() << std::endl;
+        std::cout << "   Количество студентов: " << subscriber_.getStudentCount() << std::endl;
+        std::cout << "   Для просмотра данных введите 'p'" << std::endl;
+    }
+
     void onRawMessageReceived(const std::string& message) {
+        BinarySerializer::Header header;
+        if (BinarySerializer::readHeader(message, header)) {
+            const char* kind = header.kind == BinarySerializer::MessageKind::Delta
+                                   ? "изменение" : "двоичное сообщение";
+            std::cout << "Получено " << kind << ": " << message.size() << " байт" << std::endl;
+            return;
+        }
         std::cout << "Получено сырое сообщение: " 
                   << message.substr(0, 100) 
                   << (message.length() > 100 ? "..." : "") << std::endl;
@@ -150,8 +184,8 @@ private:
             std::cout << std::left 
                       << std::setw(5) << student.getId()
 
-                      << std::setw(15) << (student.getFirstName().length() > 13 ? student.getFirstName().substr(0, 10) + "..." : student.getFirstName())
-                                            << std::setw(20) << (student.getLastName().length() > 18 ? student.getLastName().substr(0, 15) + "..." : student.getLastName())
+                      << std::setw(15) << truncateName(student.getFirstName(), 13, 10)
+                                            << std::setw(20) << truncateName(student.getLastName(), 18, 15)
                       << std::setw(15) << student.getBirthDate()
                       << std::endl;
         }
@@ -170,6 +204,13 @@ private:
         std::cout << std::endl;
     }
 
+    static std::string truncateName(std::string_view name, size_t maxLength, size_t keepLength) {
+        if (name.length() > maxLength) {
+            return std::string(name.substr(0, keepLength)) + "...";
+        }
+        return std::string(name);
+    }
+
     void displayLoop() {
         std::string command;
         
@@ -199,7 +240,13 @@ private:
         std::cout << "==================" << std::endl;
         std::cout << "Подключение: " << (subscriber_.isRunning() ? "Активно" : "Неактивно") << std::endl;
         std::cout << "Получено обновлений: " << update_count_ << std::endl;
-        std::cout << "Текущее количество студентов: " << received_students_.size() << std::endl;
+        std::cout << "Текущее количество студентов: " << subscriber_.getStudentCount() << std::endl;
+        std::cout << "Тем: " << subscriber_.getTopicCount()
+                  << (topic_.empty() ? "" : " (подписка: " + topic_ + ")") << std::endl;
+        std::cout << "Версия данных: " << subscriber_.getVersion()
+                  << " (изменений: " << subscriber_.getDeltasReceived()
+                  << ", пропущено: " << subscriber_.getDeltasSkipped()
+                  << ", запрошено снимков: " << subscriber_.getSnapshotsRequested() << ")" << std::endl;
         std::cout << "Всего сообщений: " << subscriber_.getMessagesReceived() << std::endl;
         std::cout << "Всего студентов: " << subscriber_.getStudentsReceived() << std::endl;
         std::cout << std::endl;
@@ -212,12 +259,16 @@ void printUsage(const std::string& program_name) {
     std::cout << "Использование: " << program_name << " [опции]" << std::endl;
     std::cout << "Опции:" << std::endl;
     std::cout << "  -s, --server <адрес>    Адрес сервера (по умолчанию: tcp://localhost:5556)" << std::endl;
+    std::cout << "  -n, --snapshot <адрес>  Адрес сервиса снимков (по умолчанию: tcp://localhost:5555)" << std::endl;
+    std::cout << "  -t, --topic <префикс>   Подписка на темы сервера (например: initial/И/, file/student_file_1/, id/0000001)" << std::endl;
     std::cout << "  -h, --help              Показать эту справку" << std::endl;
 }
 
 int main(int argc, char* argv[]) {
     // Обработка аргументов командной строки
     std::string server_endpoint = "tcp://localhost:5556";
+    std::string snapshot_endpoint = "tcp://localhost:5555";
+    std::string topic;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -229,6 +280,20 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Ошибка: отсутствует значение для " << arg << std::endl;
                 return 1;
             }
+        } else if (arg == "-n" || arg == "--snapshot") {
+            if (i + 1 < argc) {
+                snapshot_endpoint = argv[++i];
+            } else {
+                std::cerr << "Ошибка: отсутствует значение для " << arg << std::endl;
+                return 1;
+            }
+        } else if (arg == "-t" || arg == "--topic") {
+            if (i + 1 < argc) {
+                topic = argv[++i];
+            } else {
+                std::cerr << "Ошибка: отсутствует значение для " << arg << std::endl;
+                return 1;
+            }
         } else if (arg == "-h" || arg == "--help") {
             printUsage(argv[0]);
             return 0;
@@ -241,7 +306,7 @@ int main(int argc, char* argv[]) {
 
 
     // Создаем и запускаем клиент
-    StudentClient client(server_endpoint);
+    StudentClient client(server_endpoint, snapshot_endpoint, topic);
     
     if (!client.start()) {
         std::cerr << "Не удалось запустить клиент" << std::endl;
@@ -0,0 +1,363 @@
+/*
+ * Двоичный сериализатор списков студентов
+ * Строки с префиксом длины, varint для чисел, упакованные даты и повтор имён по ссылке
+ */
+
+#include "binary_serializer.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+constexpr char BinarySerializer::MAGIC[4];
+
+namespace {
+
+// Запись чисел varint и строк в буфер сообщения
+class Writer {
+public:
+    explicit Writer(std::string& out) : out_(out) {}
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            out_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out_.push_back(static_cast<char>(value));
+    }
+
+    void signedVarint(int64_t value) {
+        // zigzag: малые по модулю отрицательные числа тоже кодируются коротко
+        varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    // Строка со ссылкой на ранее переданную копию
+    void name(std::string_view text) {
+        auto inserted = names_.emplace(text, static_cast<uint32_t>(names_.size() + 1));
+        if (!inserted.second) {
+            varint(inserted.first->second);
+            return;
+        }
+        varint(0);
+        varint(text.size());
+        out_.append(text.data(), text.size());
+    }
+
+private:
+    std::string& out_;
+    std::unordered_map<std::string_view, uint32_t> names_;
+};
+
+// Чтение с проверкой границ; при выходе за конец бросается std::invalid_argument
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data), pos_(0) {}
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos_ >= data_.size()) {
+                fail("unexpected end of message");
+            }
+            uint8_t byte = static_cast<uint8_t>(data_[pos_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        fail("varint too long");
+        return 0;
+    }
+
+    int64_t signedVarint() {
+        uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    std::string_view name() {
+        uint64_t reference = varint();
+        if (reference != 0) {
+            if (reference > names_.size()) {
+                fail("invalid name reference");
+            }
+            return names_[reference - 1];
+        }
+        uint64_t length = varint();
+        if (length > data_.size() - pos_) {
+            fail("string exceeds message size");
+        }
+        std::string_view text = data_.substr(pos_, length);
+        pos_ += length;
+        names_.push_back(text);
+        return text;
+    }
+
+    // Число элементов не может превышать число оставшихся байт
+    size_t count() {
+        uint64_t value = varint();
+        if (value > data_.size() - pos_) {
+            fail("invalid element count");
+        }
+        return static_cast<size_t>(value);
+    }
+
+    void expectEnd() const {
+        if (pos_ != data_.size()) {
+            fail("trailing bytes after message body");
+        }
+    }
+
+    [[noreturn]] static void fail(const std::string& reason) {
+        throw std::invalid_argument("Binary decode error: " + reason);
+    }
+
+private:
+    std::string_view data_;
+    size_t pos_;
+    std::vector<std::string_view> names_;
+};
+
+// Тело сообщения без заголовка; проверяет заголовок, версию и вид сообщения
+std::string_view messageBody(std::string_view data, BinarySerializer::MessageKind kind) {
+    BinarySerializer::Header header;
+    if (!BinarySerializer::readHeader(data, header)) {
+        Reader::fail("missing binary header");
+    }
+    if (header.version != BinarySerializer::VERSION) {
+        Reader::fail("unsupported format version " + std::to_string(header.version));
+    }
+    if (header.flags & BinarySerializer::FLAG_COMPRESSED) {
+        Reader::fail("compressed message body");
+    }
+    if (header.kind != kind) {
+        switch (kind) {
+        case BinarySerializer::MessageKind::Snapshot:
+            Reader::fail("message is not a snapshot");
+        case BinarySerializer::MessageKind::Delta:
+            Reader::fail("message is not a delta");
+        case BinarySerializer::MessageKind::SnapshotChunk:
+            Reader::fail("message is not a snapshot chunk");
+        }
+        Reader::fail("unknown message kind");
+    }
+    return data.substr(BinarySerializer::HEADER_SIZE);
+}
+
+void writeStudent(Writer& writer, const Student& student) {
+    writer.signedVarint(student.getId());
+    writer.name(student.getLastName());
+    writer.name(student.getFirstName());
+    writer.signedVarint(student.getBirthDateValue().daysSinceEpoch());
+}
+
+void writeTableRow(Writer& writer, const StudentTable& students, size_t row) {
+    writer.signedVarint(students.id(row));
+    writer.name(students.lastName(row));
+    writer.name(students.firstName(row));
+    writer.signedVarint(students.birthDate(row).daysSinceEpoch());
+}
+
+void writeStudentList(Writer& writer, const std::vector<Student>& students) {
+    writer.varint(students.size());
+    for (const Student& student : students) {
+        writeStudent(writer, student);
+    }
+}
+
+template <typename Row>
+void writeSnapshot(std::string& out, uint64_t version, size_t count, const Row& row) {
+    BinarySerializer::writeHeader(BinarySerializer::Header(), out);
+
+    Writer writer(out);
+    writer.varint(version);
+    writer.varint(count);
+    for (size_t i = 0; i < count; ++i) {
+        row(i, writer);
+    }
+}
+
+// Чтение списка записей: count, затем append(count, id, имя, фамилия, дата) для каждой.
+// Записи, не прошедшие Student::isValidRecord, пропускаются, как в разборе JSON
+template <typename Append>
+void readStudentList(Reader& reader, const Append& append) {
+    size_t count = reader.count();
+    for (size_t i = 0; i < count; ++i) {
+        int64_t id = reader.signedVarint();
+        std::string_view lastName = reader.name();
+        std::string_view firstName = reader.name();
+        Date birthDate = Date::fromDaysChecked(reader.signedVarint());
+        if (Student::isValidRecord(id, firstName, lastName, birthDate)) {
+            append(count, static_cast<int>(id), firstName, lastName, birthDate);
+        }
+    }
+}
+
+std::vector<Student> readStudentVector(Reader& reader) {
+    std::vector<Student> students;
+    readStudentList(reader, [&students](size_t count, int id, std::string_view firstName,
+                                        std::string_view lastName, Date birthDate) {
+        if (students.empty()) {
+            students.reserve(count);
+        }
+        students.emplace_back(id, firstName, lastName, birthDate);
+    });
+    return students;
+}
+
+} // namespace
+
+bool BinarySerializer::isBinary(std::string_view data) {
+    return data.size() >= HEADER_SIZE && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool BinarySerializer::readHeader(std::string_view data, Header& header) {
+    if (!isBinary(data)) {
+        return false;
+    }
+    header.version = static_cast<uint8_t>(data[4]);
+    header.kind = static_cast<MessageKind>(data[5]);
+    header.flags = static_cast<uint8_t>(data[6]);
+    return true;
+}
+
+void BinarySerializer::writeHeader(const Header& header, std::string& out) {
+    out.append(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(header.version));
+    out.push_back(static_cast<char>(header.kind));
+    out.push_back(static_cast<char>(header.flags));
+    out.push_back('\0');
+}
+
+std::string BinarySerializer::serializeStudents(const std::vector<Student>& students) {
+    std::string out;
+    serializeStudents(students, out);
+    return out;
+}
+
+std::string BinarySerializer::serializeStudents(const StudentTable& students) {
+    std::string out;
+    serializeStudents(students, out);
+    return out;
+}
+
+void BinarySerializer::serializeStudents(const std::vector<Student>& students, std::string& out,
+                                         uint64_t version) {
+    out.clear();
+    out.reserve(HEADER_SIZE + students.size() * 8);
+    writeSnapshot(out, version, students.size(), [&students](size_t i, Writer& writer) {
+        writeStudent(writer, students[i]);
+    });
+}
+
+void BinarySerializer::serializeStudents(const StudentTable& students, std::string& out,
+                                         uint64_t version) {
+    out.clear();
+    out.reserve(HEADER_SIZE + students.size() * 8);
+    writeSnapshot(out, version, students.size(), [&students](size_t row, Writer& writer) {
+        writeTableRow(writer, students, row);
+    });
+}
+
+void BinarySerializer::serializeDelta(const StudentDelta& delta, std::string& out) {
+    out.clear();
+    out.reserve(HEADER_SIZE + 16 + delta.size() * 8);
+
+    Header header;
+    header.kind = MessageKind::Delta;
+    writeHeader(header, out);
+
+    Writer writer(out);
+    writer.varint(delta.baseVersion);
+    writer.varint(delta.version);
+    writeStudentList(writer, delta.added);
+    writeStudentList(writer, delta.removed);
+    writeStudentList(writer, delta.modified);
+}
+
+void BinarySerializer::serializeSnapshotChunk(const StudentTable& students, size_t begin, size_t end,
+                                              uint64_t version, size_t index, size_t count,
+                                              std::string& out) {
+    out.clear();
+    out.reserve(HEADER_SIZE + 16 + (end - begin) * 8);
+
+    Header header;
+    header.kind = MessageKind::SnapshotChunk;
+    writeHeader(header, out);
+
+    Writer writer(out);
+    writer.varint(version);
+    writer.varint(index);
+    writer.varint(count);
+    writer.varint(students.size());
+    writer.varint(end - begin);
+    for (size_t row = begin; row < end; ++row) {
+        writeTableRow(writer, students, row);
+    }
+}
+
+std::vector<Student> BinarySerializer::deserializeStudents(std::string_view data) {
+    Reader reader(messageBody(data, MessageKind::Snapshot));
+    reader.varint();
+    std::vector<Student> students = readStudentVector(reader);
+    reader.expectEnd();
+    return students;
+}
+
+StudentTable BinarySerializer::deserializeStudentTable(std::string_view data) {
+    Reader reader(messageBody(data, MessageKind::Snapshot));
+    reader.varint();
+
+    StudentTable table;
+    readStudentList(reader, [&table](size_t count, int id, std::string_view firstName,
+                                     std::string_view lastName, Date birthDate) {
+        if (table.empty()) {
+            table.reserve(count);
+        }
+        table.append(id, firstName, lastName, birthDate);
+    });
+    reader.expectEnd();
+    return table;
+}
+
+StudentDelta BinarySerializer::deserializeDelta(std::string_view data) {
+    Reader reader(messageBody(data, MessageKind::Delta));
+
+    StudentDelta delta;
+    delta.baseVersion = reader.varint();
+    delta.version = reader.varint();
+    delta.added = readStudentVector(reader);
+    delta.removed = readStudentVector(reader);
+    delta.modified = readStudentVector(reader);
+    reader.expectEnd();
+    return delta;
+}
+
+BinarySerializer::SnapshotChunk BinarySerializer::deserializeSnapshotChunk(std::string_view data) {
+    Reader reader(messageBody(data, MessageKind::SnapshotChunk));
+
+    SnapshotChunk chunk;
+    chunk.version = reader.varint();
+    chunk.index = static_cast<size_t>(reader.varint());
+    chunk.count = static_cast<size_t>(reader.varint());
+    chunk.totalRecords = static_cast<size_t>(reader.varint());
+    if (chunk.index >= chunk.count) {
+        Reader::fail("invalid chunk index");
+    }
+    chunk.students = readStudentVector(reader);
+    if (chunk.students.size() > chunk.totalRecords) {
+        Reader::fail("chunk exceeds snapshot size");
+    }
+    reader.expectEnd();
+    return chunk;
+}
+
+uint64_t BinarySerializer::readVersion(std::string_view data) {
+    Header header;
+    if (!readHeader(data, header)) {
+        Reader::fail("missing binary header");
+    }
+    Reader reader(messageBody(data, header.kind));
+    if (header.kind == MessageKind::Delta) {
+        reader.varint();
+    }
+    return reader.varint();
+}
@@ -0,0 +1,112 @@
+#ifndef BINARY_SERIALIZER_HPP
+#define BINARY_SERIALIZER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "student.hpp"
+#include "student_table.hpp"
+#include "student_delta.hpp"
+
+// Компактный двоичный формат списка студентов.
+//
+// Заголовок (8 байт):
+//   magic   "\0SDB"  - нулевой первый байт не встречается в JSON, по нему
+//                      подписчик отличает двоичное сообщение от текстового
+//   version uint8    - версия формата
+//   kind    uint8    - вид сообщения (MessageKind)
+//   flags   uint8    - флаги сообщения (FLAG_COMPRESSED - тело сжато, см. PayloadCodec)
+//   reserved uint8
+//
+// Тело снимка (Snapshot):
+//   varint  номер версии списка (0 - снимок вне цепочки версий)
+//   varint  count
+//   count записей:
+//     varint  id (zigzag)
+//     name    фамилия
+//     name    имя
+//     varint  дата рождения - дни от 01.01.1970 (zigzag)
+//
+// Часть снимка (SnapshotChunk) - большой снимок передаётся несколькими
+// сообщениями, каждое разбирается независимо (своя таблица имён):
+//   varint  номер версии списка
+//   varint  номер части, varint  число частей
+//   varint  число записей во всём снимке
+//   список записей части в формате снимка (count + записи)
+//
+// Тело изменения (Delta):
+//   varint  базовая версия, varint  новая версия
+//   три списка записей в формате снимка (count + записи):
+//   добавленные, удалённые, изменённые
+//
+// name - varint ссылка: 0 - новая строка (varint длина + байты UTF-8),
+// n > 0 - повтор n-й по счёту новой строки сообщения. Повторяющиеся имена
+// передаются один раз.
+class BinarySerializer {
+public:
+    static constexpr uint8_t VERSION = 2;
+    static constexpr size_t HEADER_SIZE = 8;
+    static constexpr uint8_t FLAG_COMPRESSED = 0x01;
+
+    enum class MessageKind : uint8_t {
+        Snapshot = 1,
+        Delta = 2,
+        SnapshotChunk = 3
+    };
+
+    struct Header {
+        uint8_t version;
+        MessageKind kind;
+        uint8_t flags;
+
+        Header() : version(VERSION), kind(MessageKind::Snapshot), flags(0) {}
+    };
+
+    // Разобранная часть снимка
+    struct SnapshotChunk {
+        uint64_t version = 0;
+        size_t index = 0;
+        size_t count = 0;
+        size_t totalRecords = 0;
+        std::vector<Student> students;
+    };
+
+    // Начинается ли сообщение с двоичного заголовка
+    static bool isBinary(std::string_view data);
+
+    // Разбор заголовка; false, если это не двоичное сообщение
+    static bool readHeader(std::string_view data, Header& header);
+
+    // Запись заголовка в конец out
+    static void writeHeader(const Header& header, std::string& out);
+
+    static std::string serializeStudents(const std::vector<Student>& students);
+    static std::string serializeStudents(const StudentTable& students);
+
+    // Запись в буфер вызывающего; содержимое out заменяется, память переиспользуется
+    static void serializeStudents(const std::vector<Student>& students, std::string& out,
+                                  uint64_t version = 0);
+    static void serializeStudents(const StudentTable& students, std::string& out,
+                                  uint64_t version = 0);
+    static void serializeDelta(const StudentDelta& delta, std::string& out);
+    // Часть index из count: записи [begin, end) таблицы
+    static void serializeSnapshotChunk(const StudentTable& students, size_t begin, size_t end,
+                                       uint64_t version, size_t index, size_t count,
+                                       std::string& out);
+
+    // При повреждённых данных, неизвестной версии или сжатом теле бросают std::invalid_argument
+    static std::vector<Student> deserializeStudents(std::string_view data);
+    static StudentTable deserializeStudentTable(std::string_view data);
+    static StudentDelta deserializeDelta(std::string_view data);
+    static SnapshotChunk deserializeSnapshotChunk(std::string_view data);
+
+    // Номер версии снимка (или его части) или новая версия изменения (без разбора записей)
+    static uint64_t readVersion(std::string_view data);
+
+private:
+    static constexpr char MAGIC[4] = {'\0', 'S', 'D', 'B'};
+};
+
+#endif // BINARY_SERIALIZER_HPP
@@ -0,0 +1,24 @@
+/*
+ * Компактный тип даты рождения
+ * Проверки на этапе компиляции и форматирование в строку
+ */
+
+#include "date.hpp"
+
+static_assert(sizeof(Date) == 4, "Date must stay 32 bits");
+static_assert(Date::parse("01.01.1970").daysSinceEpoch() == 0, "epoch");
+static_assert(Date::parse("29.02.2000").isValid(), "leap year");
+static_assert(!Date::parse("29.02.1900").isValid(), "1900 is not a leap year");
+static_assert(!Date::parse("31.04.2000").isValid(), "April has 30 days");
+static_assert(!Date::parse("32.13.1990").isValid(), "out of range");
+static_assert(Date::parse("04.5.1987").month() == 5, "single digit month");
+static_assert(!Date::parse("01.01.1990x").isValid(), "trailing characters");
+
+std::string Date::toString() const {
+    if (!isValid()) {
+        return "";
+    }
+    std::string result(TEXT_LENGTH, '0');
+    format(&result[0]);
+    return result;
+}
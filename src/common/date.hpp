@@ -0,0 +1,164 @@
+#ifndef DATE_HPP
+#define DATE_HPP
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <climits>
+
+// Компактная дата: число дней от 01.01.1970 в 32 битах.
+// Разбор и проверка формата DD.MM.YYYY выполняются без выделения памяти,
+// без потоков и без std::mktime, поэтому безопасны из любых потоков.
+class Date {
+public:
+    static constexpr int MIN_YEAR = 1900;
+    static constexpr int MAX_YEAR = 2100;
+    static constexpr size_t TEXT_LENGTH = 10; // DD.MM.YYYY
+
+    constexpr Date() : days_(INVALID_DAYS) {}
+
+    static constexpr Date fromDays(int32_t days) { return Date(days); }
+
+    // Число дней из внешнего источника: вне годов MIN_YEAR..MAX_YEAR - невалидная дата
+    static constexpr Date fromDaysChecked(int64_t days) {
+        return days < daysFromCivil(1, 1, MIN_YEAR) || days > daysFromCivil(31, 12, MAX_YEAR)
+            ? Date() : Date(static_cast<int32_t>(days));
+    }
+
+    // Дата из дня, месяца и года; для несуществующей даты возвращается невалидная
+    static constexpr Date fromCivil(int day, int month, int year) {
+        if (!isValidCivil(day, month, year)) {
+            return Date();
+        }
+        return Date(daysFromCivil(day, month, year));
+    }
+
+    // Разбор строки DD.MM.YYYY (день и месяц допускаются из одной цифры)
+    static constexpr bool parse(std::string_view text, Date& result) {
+        size_t pos = 0;
+        int day = 0, month = 0, year = 0;
+
+        if (!parseNumber(text, pos, 1, 2, day) || !expectDot(text, pos) ||
+            !parseNumber(text, pos, 1, 2, month) || !expectDot(text, pos) ||
+            !parseNumber(text, pos, 4, 4, year) || pos != text.size()) {
+            return false;
+        }
+
+        if (!isValidCivil(day, month, year)) {
+            return false;
+        }
+
+        result = Date(daysFromCivil(day, month, year));
+        return true;
+    }
+
+    static constexpr Date parse(std::string_view text) {
+        Date result;
+        return parse(text, result) ? result : Date();
+    }
+
+    static constexpr bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    static constexpr int daysInMonth(int month, int year) {
+        constexpr int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return (month == 2 && isLeapYear(year)) ? 29 : days[month - 1];
+    }
+
+    static constexpr bool isValidCivil(int day, int month, int year) {
+        return year >= MIN_YEAR && year <= MAX_YEAR &&
+               month >= 1 && month <= 12 &&
+               day >= 1 && day <= daysInMonth(month, year);
+    }
+
+    constexpr bool isValid() const { return days_ != INVALID_DAYS; }
+    constexpr int32_t daysSinceEpoch() const { return days_; }
+
+    constexpr int day() const { return civil().day; }
+    constexpr int month() const { return civil().month; }
+    constexpr int year() const { return civil().year; }
+
+    // Запись в буфер из TEXT_LENGTH символов без завершающего нуля
+    constexpr void format(char* out) const {
+        Civil c = civil();
+        out[0] = static_cast<char>('0' + c.day / 10);
+        out[1] = static_cast<char>('0' + c.day % 10);
+        out[2] = '.';
+        out[3] = static_cast<char>('0' + c.month / 10);
+        out[4] = static_cast<char>('0' + c.month % 10);
+        out[5] = '.';
+        out[6] = static_cast<char>('0' + c.year / 1000);
+        out[7] = static_cast<char>('0' + c.year / 100 % 10);
+        out[8] = static_cast<char>('0' + c.year / 10 % 10);
+        out[9] = static_cast<char>('0' + c.year % 10);
+    }
+
+    // DD.MM.YYYY или пустая строка для невалидной даты
+    std::string toString() const;
+
+    constexpr bool operator==(const Date& other) const { return days_ == other.days_; }
+    constexpr bool operator!=(const Date& other) const { return days_ != other.days_; }
+    constexpr bool operator<(const Date& other) const { return days_ < other.days_; }
+
+private:
+    struct Civil {
+        int day;
+        int month;
+        int year;
+    };
+
+    static constexpr int32_t INVALID_DAYS = INT32_MIN;
+
+    explicit constexpr Date(int32_t days) : days_(days) {}
+
+    static constexpr bool parseNumber(std::string_view text, size_t& pos,
+                                      size_t minDigits, size_t maxDigits, int& value) {
+        size_t digits = 0;
+        value = 0;
+        while (pos < text.size() && digits < maxDigits &&
+               text[pos] >= '0' && text[pos] <= '9') {
+            value = value * 10 + (text[pos] - '0');
+            ++pos;
+            ++digits;
+        }
+        return digits >= minDigits;
+    }
+
+    static constexpr bool expectDot(std::string_view text, size_t& pos) {
+        if (pos < text.size() && text[pos] == '.') {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    // Преобразования между календарной датой и днями от эпохи
+    // (алгоритм days_from_civil / civil_from_days Говарда Хиннанта)
+    static constexpr int32_t daysFromCivil(int day, int month, int year) {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(year - era * 400);
+        const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int32_t>(doe) - 719468;
+    }
+
+    constexpr Civil civil() const {
+        const int32_t z = days_ + 719468;
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const int d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        const int m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        const int y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+        return Civil{d, m, y};
+    }
+
+private:
+    int32_t days_;
+};
+
+#endif // DATE_HPP
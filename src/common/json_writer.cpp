@@ -0,0 +1,121 @@
+/*
+ * Потоковая запись JSON без построения дерева
+ * Формат вывода повторяет nlohmann::json::dump, чтобы клиенты не заметили разницы
+ */
+
+#include "json_writer.hpp"
+#include <charconv>
+
+JsonWriter::JsonWriter(std::string& out, int indent)
+    : out_(out), indent_(indent), afterKey_(false) {
+    counts_.reserve(8);
+}
+
+void JsonWriter::beginObject() {
+    beforeValue();
+    out_.push_back('{');
+    counts_.push_back(0);
+}
+
+void JsonWriter::endObject() {
+    close('}');
+}
+
+void JsonWriter::beginArray() {
+    beforeValue();
+    out_.push_back('[');
+    counts_.push_back(0);
+}
+
+void JsonWriter::endArray() {
+    close(']');
+}
+
+void JsonWriter::key(std::string_view name) {
+    beforeValue();
+    appendEscaped(out_, name);
+    out_.push_back(':');
+    if (indent_ >= 0) {
+        out_.push_back(' ');
+    }
+    afterKey_ = true;
+}
+
+void JsonWriter::value(std::string_view text) {
+    beforeValue();
+    appendEscaped(out_, text);
+}
+
+void JsonWriter::value(int64_t number) {
+    beforeValue();
+    char buffer[24];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+}
+
+void JsonWriter::beforeValue() {
+    // Значение после ключа продолжает ту же строку
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (counts_.empty()) {
+        return;
+    }
+    if (counts_.back()++ > 0) {
+        out_.push_back(',');
+    }
+    newline(counts_.size());
+}
+
+void JsonWriter::close(char bracket) {
+    // Пустые контейнеры пишутся как {} и [] без переводов строк
+    bool empty = counts_.back() == 0;
+    counts_.pop_back();
+    if (!empty) {
+        newline(counts_.size());
+    }
+    out_.push_back(bracket);
+}
+
+void JsonWriter::newline(size_t depth) {
+    if (indent_ < 0) {
+        return;
+    }
+    out_.push_back('\n');
+    out_.append(depth * static_cast<size_t>(indent_), ' ');
+}
+
+void JsonWriter::appendEscaped(std::string& out, std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+
+    out.push_back('"');
+    size_t plain = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        // Неэкранируемый участок копируется целиком
+        out.append(text.data() + plain, i - plain);
+        plain = i + 1;
+
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default: {
+                char escaped[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0x0F]};
+                out.append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+    }
+    out.append(text.data() + plain, text.size() - plain);
+    out.push_back('"');
+}
@@ -0,0 +1,42 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// Потоковая запись JSON прямо в строку вызывающего, без промежуточного DOM.
+// Вывод совпадает байт в байт с nlohmann::json::dump(indent):
+// indent < 0 - компактная запись, indent >= 0 - с отступами.
+// Ключи объектов пишутся в том порядке, в котором их передаёт вызывающий.
+class JsonWriter {
+public:
+    // Запись дописывается в конец out
+    explicit JsonWriter(std::string& out, int indent = -1);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void key(std::string_view name);
+    void value(std::string_view text);
+    void value(int64_t number);
+
+    // Строка в кавычках с экранированием по правилам JSON
+    static void appendEscaped(std::string& out, std::string_view text);
+
+private:
+    void beforeValue();
+    void close(char bracket);
+    void newline(size_t depth);
+
+private:
+    std::string& out_;
+    int indent_;
+    std::vector<uint32_t> counts_;  // число элементов на каждом уровне вложенности
+    bool afterKey_;
+};
+
+#endif // JSON_WRITER_HPP
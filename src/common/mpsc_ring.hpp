@@ -0,0 +1,228 @@
+#ifndef MPSC_RING_HPP
+#define MPSC_RING_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// Статистика очереди; общая для всех типов элементов
+struct MpscRingStats {
+    size_t pushed = 0;          // принято элементов
+    size_t contended = 0;       // повторов CAS из-за других производителей
+    size_t fullWaits = 0;       // ожиданий места в заполненной очереди
+    size_t consumerSleeps = 0;  // засыпаний потребителя на пустой очереди
+    size_t highWater = 0;       // наибольшая глубина после записи
+};
+
+// Ограниченная очередь без блокировок: много производителей, один потребитель.
+//
+// Кольцо ячеек с порядковыми номерами (схема Д. Вьюкова): производитель
+// резервирует позицию одним CAS и публикует элемент записью номера ячейки.
+// Извлечение тоже идёт через CAS: кроме потребителя, старые элементы может
+// вытеснить производитель (tryEvict при заполненной очереди). Мьютекс и
+// условные переменные используются только для сна: производитель трогает их,
+// лишь если потребитель действительно ждёт, и наоборот.
+//
+// Запись lock-free, а не wait-free: CAS повторяется, только если позицию занял
+// другой производитель, то есть система в целом продвигается, но отдельный
+// поток может повторять CAS несколько раз. Так сделано намеренно. Запись
+// билетами (fetch_add без повторов) не может вернуть билет: tryPush не смог бы
+// отказать при заполненной очереди, а вытеснение tryEvict при KeepLatest
+// ждало бы чужого билета. Число повторов видно в Stats::contended.
+//
+// Статистика: число повторов CAS (конкуренция производителей), ожиданий
+// свободного места, засыпаний потребителя и наибольшая глубина очереди.
+template <typename T>
+class MpscRing {
+public:
+    using Stats = MpscRingStats;
+
+    // Ёмкость округляется вверх до степени двойки
+    explicit MpscRing(size_t capacity)
+        : capacity_(roundUp(capacity)), mask_(capacity_ - 1),
+          cells_(new Cell[capacity_]), enqueuePos_(0), dequeuePos_(0),
+          consumerWaiting_(false), producersWaiting_(0),
+          contended_(0), fullWaits_(0), consumerSleeps_(0), highWater_(0) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    // Приблизительная глубина: точна, только пока очередь не меняется
+    size_t size() const {
+        size_t tail = enqueuePos_.load(std::memory_order_acquire);
+        size_t head = dequeuePos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Lock-free; false, если очередь заполнена (value не изменяется)
+    bool tryPush(T&& value) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+                contended_.fetch_add(1, std::memory_order_relaxed);
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        updateHighWater(pos + 1 - dequeuePos_.load(std::memory_order_relaxed));
+
+        // Потребитель будится, только если он объявил о сне
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerWaiting_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dataCv_.notify_one();
+        }
+        return true;
+    }
+
+    // Ожидание места, затем запись; false, если interrupt стал true
+    bool push(T&& value, const std::atomic<bool>& interrupt) {
+        while (!tryPush(std::move(value))) {
+            fullWaits_.fetch_add(1, std::memory_order_relaxed);
+            std::unique_lock<std::mutex> lock(mutex_);
+            producersWaiting_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            spaceCv_.wait(lock, [this, &interrupt] {
+                return size() < capacity_ || interrupt.load();
+            });
+            producersWaiting_.fetch_sub(1, std::memory_order_relaxed);
+            if (interrupt.load()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Извлечение самого старого элемента; false, если очередь пуста
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->sequence.store(pos + capacity_, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producersWaiting_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            spaceCv_.notify_all();
+        }
+        return true;
+    }
+
+    // Вытеснение самого старого элемента производителем, чтобы освободить место
+    bool tryEvict(T& value) {
+        return tryPop(value);
+    }
+
+    // Сон потребителя, пока очередь пуста и interrupt не установлен
+    void waitForData(const std::atomic<bool>& interrupt) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        consumerWaiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (empty() && !interrupt.load()) {
+            consumerSleeps_.fetch_add(1, std::memory_order_relaxed);
+            dataCv_.wait(lock, [this, &interrupt] { return !empty() || interrupt.load(); });
+        }
+        consumerWaiting_.store(false, std::memory_order_relaxed);
+    }
+
+    // Пробуждение всех ожидающих, например после установки флага остановки
+    void wakeAll() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dataCv_.notify_all();
+        spaceCv_.notify_all();
+    }
+
+    Stats stats() const {
+        Stats result;
+        result.pushed = enqueuePos_.load(std::memory_order_relaxed);
+        result.contended = contended_.load(std::memory_order_relaxed);
+        result.fullWaits = fullWaits_.load(std::memory_order_relaxed);
+        result.consumerSleeps = consumerSleeps_.load(std::memory_order_relaxed);
+        result.highWater = highWater_.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Обычно глубина не растёт, и CAS не выполняется
+    void updateHighWater(size_t depth) {
+        size_t current = highWater_.load(std::memory_order_relaxed);
+        while (depth > current && depth <= capacity_ &&
+               !highWater_.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    static size_t roundUp(size_t capacity) {
+        size_t result = 2;
+        while (result < capacity) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // Позиции на отдельных строках кэша: производители и потребитель не мешают друг другу
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePos_;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePos_;
+
+    alignas(CACHE_LINE) std::atomic<bool> consumerWaiting_;
+    std::atomic<int> producersWaiting_;
+    std::mutex mutex_;
+    std::condition_variable dataCv_;
+    std::condition_variable spaceCv_;
+
+    std::atomic<size_t> contended_;
+    std::atomic<size_t> fullWaits_;
+    std::atomic<size_t> consumerSleeps_;
+    std::atomic<size_t> highWater_;
+};
+
+#endif // MPSC_RING_HPP
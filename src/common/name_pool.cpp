@@ -0,0 +1,72 @@
+/*
+ * Пул интернированных имён студентов
+ * Хранит по одной копии каждой фамилии и имени в арене из крупных блоков
+ */
+
+#include "name_pool.hpp"
+#include <cstring>
+
+NamePool::NamePool() : current_(nullptr), blockUsed_(BLOCK_SIZE), arenaBytes_(0) {
+}
+
+NamePool& NamePool::global() {
+    static NamePool pool;
+    return pool;
+}
+
+InternedName NamePool::intern(std::string_view name) {
+    if (name.empty()) {
+        return InternedName();
+    }
+
+    // Быстрый путь: имя уже в пуле, достаточно разделяемой блокировки
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = names_.find(name);
+        if (it != names_.end()) {
+            return InternedName(*it);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = names_.find(name);
+    if (it != names_.end()) {
+        return InternedName(*it);
+    }
+
+    std::string_view stored(store(name), name.size());
+    names_.insert(stored);
+    return InternedName(stored);
+}
+
+const char* NamePool::store(std::string_view name) {
+    // Длинные имена получают собственный блок, чтобы не тратить остаток текущего
+    if (name.size() > BLOCK_SIZE / 4) {
+        blocks_.push_back(std::make_unique<char[]>(name.size()));
+        std::memcpy(blocks_.back().get(), name.data(), name.size());
+        arenaBytes_ += name.size();
+        return blocks_.back().get();
+    }
+
+    if (blockUsed_ + name.size() > BLOCK_SIZE) {
+        blocks_.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+        current_ = blocks_.back().get();
+        blockUsed_ = 0;
+        arenaBytes_ += BLOCK_SIZE;
+    }
+
+    char* destination = current_ + blockUsed_;
+    std::memcpy(destination, name.data(), name.size());
+    blockUsed_ += name.size();
+    return destination;
+}
+
+size_t NamePool::uniqueNames() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+size_t NamePool::arenaBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return arenaBytes_;
+}
@@ -0,0 +1,68 @@
+#ifndef NAME_POOL_HPP
+#define NAME_POOL_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <functional>
+
+// Ссылка на интернированную строку из NamePool.
+// Одинаковые строки из одного пула имеют один и тот же адрес,
+// поэтому сравнение и хэширование работают по указателю, а не по символам.
+class InternedName {
+public:
+    InternedName() = default;
+
+    std::string_view view() const { return view_; }
+    bool empty() const { return view_.empty(); }
+    size_t size() const { return view_.size(); }
+
+    bool operator==(const InternedName& other) const { return view_.data() == other.view_.data(); }
+    bool operator!=(const InternedName& other) const { return !(*this == other); }
+
+    size_t hash() const { return std::hash<const void*>{}(view_.data()); }
+
+private:
+    friend class NamePool;
+    explicit InternedName(std::string_view view) : view_(view) {}
+
+    std::string_view view_;
+};
+
+// Потокобезопасный пул интернированных имён.
+// Символы хранятся в арене из крупных блоков и не освобождаются до конца
+// работы процесса, поэтому InternedName остаётся валидным всегда.
+class NamePool {
+public:
+    NamePool();
+    NamePool(const NamePool&) = delete;
+    NamePool& operator=(const NamePool&) = delete;
+
+    // Общий пул, которым пользуются Student, DataParser и Serializer
+    static NamePool& global();
+
+    InternedName intern(std::string_view name);
+
+    // Статистика
+    size_t uniqueNames() const;
+    size_t arenaBytes() const;
+
+private:
+    const char* store(std::string_view name);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_set<std::string_view> names_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* current_;      // текущий блок обычного размера
+    size_t blockUsed_;
+    size_t arenaBytes_;
+};
+
+#endif // NAME_POOL_HPP
@@ -0,0 +1,216 @@
+/*
+ * Сжатие тел двоичных сообщений zstd с общим словарём
+ */
+
+#include "payload_codec.hpp"
+#include "binary_serializer.hpp"
+#include <stdexcept>
+
+#ifdef STUDENT_HAVE_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
+namespace {
+
+[[noreturn]] void fail(const std::string& reason) {
+    throw std::invalid_argument("Compressed payload error: " + reason);
+}
+
+std::string_view messageBody(std::string_view message) {
+    return message.substr(BinarySerializer::HEADER_SIZE);
+}
+
+// Байт флагов в заголовке
+constexpr size_t FLAGS_OFFSET = 6;
+
+#ifdef STUDENT_HAVE_ZSTD
+
+// Контексты zstd не потокобезопасны: у каждого потока свои, создаются при первом вызове
+struct ThreadContexts {
+    ZSTD_CCtx* compress = nullptr;
+    ZSTD_DCtx* decompress = nullptr;
+
+    ~ThreadContexts() {
+        ZSTD_freeCCtx(compress);
+        ZSTD_freeDCtx(decompress);
+    }
+};
+
+ThreadContexts& threadContexts() {
+    thread_local ThreadContexts contexts;
+    return contexts;
+}
+
+#endif
+
+} // namespace
+
+#ifdef STUDENT_HAVE_ZSTD
+
+// Подготовленные словари: разбираются один раз и только читаются
+struct PayloadCodec::Dictionaries {
+    ZSTD_CDict* compress = nullptr;
+    ZSTD_DDict* decompress = nullptr;
+
+    ~Dictionaries() {
+        ZSTD_freeCDict(compress);
+        ZSTD_freeDDict(decompress);
+    }
+};
+
+bool PayloadCodec::available() {
+    return true;
+}
+
+PayloadCodec::PayloadCodec(std::string dictionary, int level)
+    : dictionary_(std::move(dictionary)), dictionary_id_(0), level_(level),
+      dictionaries_(std::make_unique<Dictionaries>()) {
+    if (dictionary_.empty()) {
+        return;
+    }
+    dictionary_id_ = ZSTD_getDictID_fromDict(dictionary_.data(), dictionary_.size());
+    dictionaries_->compress = ZSTD_createCDict(dictionary_.data(), dictionary_.size(), level_);
+    dictionaries_->decompress = ZSTD_createDDict(dictionary_.data(), dictionary_.size());
+    if (!dictionaries_->compress || !dictionaries_->decompress) {
+        throw std::invalid_argument("Compressed payload error: invalid dictionary");
+    }
+}
+
+bool PayloadCodec::compress(std::string_view message, std::string& out) const {
+    BinarySerializer::Header header;
+    if (!BinarySerializer::readHeader(message, header) ||
+        (header.flags & BinarySerializer::FLAG_COMPRESSED) ||
+        message.size() < BinarySerializer::HEADER_SIZE + MIN_COMPRESS_SIZE) {
+        return false;
+    }
+
+    ThreadContexts& contexts = threadContexts();
+    if (!contexts.compress) {
+        contexts.compress = ZSTD_createCCtx();
+    }
+
+    std::string_view body = messageBody(message);
+    out.resize(BinarySerializer::HEADER_SIZE + ZSTD_compressBound(body.size()));
+    out.replace(0, BinarySerializer::HEADER_SIZE, message.data(), BinarySerializer::HEADER_SIZE);
+    out[FLAGS_OFFSET] = static_cast<char>(header.flags | BinarySerializer::FLAG_COMPRESSED);
+
+    char* destination = &out[BinarySerializer::HEADER_SIZE];
+    size_t capacity = out.size() - BinarySerializer::HEADER_SIZE;
+    size_t written = dictionaries_->compress
+        ? ZSTD_compress_usingCDict(contexts.compress, destination, capacity,
+                                   body.data(), body.size(), dictionaries_->compress)
+        : ZSTD_compressCCtx(contexts.compress, destination, capacity,
+                            body.data(), body.size(), level_);
+    if (ZSTD_isError(written) || written >= body.size()) {
+        return false;
+    }
+    out.resize(BinarySerializer::HEADER_SIZE + written);
+    return true;
+}
+
+void PayloadCodec::decompress(std::string_view message, std::string& out) const {
+    if (!isCompressed(message)) {
+        fail("message is not compressed");
+    }
+    std::string_view body = messageBody(message);
+
+    unsigned long long size = ZSTD_getFrameContentSize(body.data(), body.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN) {
+        fail("invalid frame");
+    }
+    if (size > MAX_DECOMPRESSED_SIZE) {
+        fail("frame too large");
+    }
+    uint32_t dictionaryId = ZSTD_getDictID_fromFrame(body.data(), body.size());
+    if (dictionaryId != dictionary_id_) {
+        fail("dictionary " + std::to_string(dictionaryId) + " is not loaded");
+    }
+
+    ThreadContexts& contexts = threadContexts();
+    if (!contexts.decompress) {
+        contexts.decompress = ZSTD_createDCtx();
+    }
+
+    out.resize(BinarySerializer::HEADER_SIZE + static_cast<size_t>(size));
+    out.replace(0, BinarySerializer::HEADER_SIZE, message.data(), BinarySerializer::HEADER_SIZE);
+    out[FLAGS_OFFSET] = static_cast<char>(out[FLAGS_OFFSET] & ~BinarySerializer::FLAG_COMPRESSED);
+
+    char* destination = &out[BinarySerializer::HEADER_SIZE];
+    size_t read = dictionaries_->decompress
+        ? ZSTD_decompress_usingDDict(contexts.decompress, destination, static_cast<size_t>(size),
+                                     body.data(), body.size(), dictionaries_->decompress)
+        : ZSTD_decompressDCtx(contexts.decompress, destination, static_cast<size_t>(size),
+                              body.data(), body.size());
+    if (ZSTD_isError(read) || read != size) {
+        fail("corrupted frame");
+    }
+}
+
+uint32_t PayloadCodec::messageDictionaryId(std::string_view message) {
+    if (!isCompressed(message)) {
+        return 0;
+    }
+    std::string_view body = messageBody(message);
+    return ZSTD_getDictID_fromFrame(body.data(), body.size());
+}
+
+std::string PayloadCodec::trainDictionary(const std::vector<std::string>& samples,
+                                          size_t capacity) {
+    std::string buffer;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const std::string& sample : samples) {
+        buffer += sample;
+        sizes.push_back(sample.size());
+    }
+
+    std::string dictionary(capacity, '\0');
+    size_t size = ZDICT_trainFromBuffer(&dictionary[0], capacity, buffer.data(), sizes.data(),
+                                        static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(size)) {
+        return std::string();
+    }
+    dictionary.resize(size);
+    return dictionary;
+}
+
+#else
+
+// Сборка без zstd: сообщения передаются несжатыми
+struct PayloadCodec::Dictionaries {};
+
+bool PayloadCodec::available() {
+    return false;
+}
+
+PayloadCodec::PayloadCodec(std::string dictionary, int level)
+    : dictionary_(std::move(dictionary)), dictionary_id_(0), level_(level) {
+    throw std::runtime_error("PayloadCodec: built without zstd");
+}
+
+bool PayloadCodec::compress(std::string_view, std::string&) const {
+    return false;
+}
+
+void PayloadCodec::decompress(std::string_view, std::string&) const {
+    fail("built without zstd");
+}
+
+uint32_t PayloadCodec::messageDictionaryId(std::string_view) {
+    return 0;
+}
+
+std::string PayloadCodec::trainDictionary(const std::vector<std::string>&, size_t) {
+    return std::string();
+}
+
+#endif
+
+PayloadCodec::~PayloadCodec() = default;
+
+bool PayloadCodec::isCompressed(std::string_view message) {
+    BinarySerializer::Header header;
+    return BinarySerializer::readHeader(message, header) &&
+           (header.flags & BinarySerializer::FLAG_COMPRESSED);
+}
@@ -0,0 +1,75 @@
+#ifndef PAYLOAD_CODEC_HPP
+#define PAYLOAD_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Сжатие двоичных сообщений zstd с общим словарём.
+//
+// Сжимается только тело: заголовок остаётся прежним, в нём устанавливается
+// флаг BinarySerializer::FLAG_COMPRESSED, поэтому вид сообщения и номер
+// версии видны без распаковки. Тело - кадр zstd с размером исходных данных
+// и номером словаря.
+//
+// Словарь обучается на примерах сообщений (trainDictionary): имена, даты и
+// служебные байты повторяются от сообщения к сообщению, и даже небольшое
+// изменение сжимается так же хорошо, как большой снимок.
+//
+// zstd - необязательная зависимость (STUDENT_HAVE_ZSTD): без неё available()
+// возвращает false, а конструктор бросает std::runtime_error.
+// Методы const безопасны для вызова из нескольких потоков.
+class PayloadCodec {
+public:
+    static constexpr int DEFAULT_LEVEL = 3;
+    static constexpr size_t DEFAULT_DICTIONARY_SIZE = 16 * 1024;
+    // Короткие сообщения не сжимаются: выигрыш меньше затрат
+    static constexpr size_t MIN_COMPRESS_SIZE = 64;
+    // Предел размера распакованного тела - защита от повреждённых сообщений
+    static constexpr size_t MAX_DECOMPRESSED_SIZE = size_t(1) << 30;
+
+    // Собран ли проект с zstd
+    static bool available();
+
+    // Пустой словарь - сжатие без словаря
+    explicit PayloadCodec(std::string dictionary = std::string(), int level = DEFAULT_LEVEL);
+    ~PayloadCodec();
+
+    PayloadCodec(const PayloadCodec&) = delete;
+    PayloadCodec& operator=(const PayloadCodec&) = delete;
+
+    const std::string& dictionary() const { return dictionary_; }
+    // Номер словаря из его заголовка; 0 - словаря нет
+    uint32_t dictionaryId() const { return dictionary_id_; }
+
+    // Сжатие двоичного сообщения в out; false, если сжимать не стоит
+    // (не двоичное, уже сжатое, короткое или не уменьшилось) - out не определён
+    bool compress(std::string_view message, std::string& out) const;
+
+    // Распаковка в out (заголовок без флага сжатия); при повреждённых данных
+    // или другом словаре бросает std::invalid_argument
+    void decompress(std::string_view message, std::string& out) const;
+
+    static bool isCompressed(std::string_view message);
+
+    // Номер словаря, которым сжато сообщение; 0 - без словаря
+    static uint32_t messageDictionaryId(std::string_view message);
+
+    // Обучение словаря на примерах сообщений (целиком, с заголовками).
+    // Пустая строка, если примеров недостаточно
+    static std::string trainDictionary(const std::vector<std::string>& samples,
+                                       size_t capacity = DEFAULT_DICTIONARY_SIZE);
+
+private:
+    struct Dictionaries;
+
+    std::string dictionary_;
+    uint32_t dictionary_id_;
+    int level_;
+    std::unique_ptr<Dictionaries> dictionaries_;
+};
+
+#endif // PAYLOAD_CODEC_HPP
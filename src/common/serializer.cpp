@@ -4,6 +4,7 @@
  */
 
 #include "serializer.hpp"
+#include "json_writer.hpp"
 #include <sstream>
 
 const std::string Serializer::STUDENTS_KEY = "students";
@@ -26,51 +27,386 @@ Student Serializer::jsonToStudent(const json& j) {
         throw std::invalid_argument("Invalid student JSON");
     }
     
+    // Имена передаются по ссылке и сразу интернируются в конструкторе Student
     int id = j[ID_KEY].get<int>();
-    std::string firstName = j[FIRST_NAME_KEY].get<std::string>();
-    std::string lastName = j[LAST_NAME_KEY].get<std::string>();
-    std::string birthDate = j[BIRTH_DATE_KEY].get<std::string>();
+    const std::string& firstName = j[FIRST_NAME_KEY].get_ref<const std::string&>();
+    const std::string& lastName = j[LAST_NAME_KEY].get_ref<const std::string&>();
+    const std::string& birthDate = j[BIRTH_DATE_KEY].get_ref<const std::string&>();
     
     return Student(id, firstName, lastName, birthDate);
 }
 
 std::string Serializer::serializeStudents(const std::vector<Student>& students) {
-    json j;
-    j[STUDENTS_KEY] = json::array();
-    
-    for (const Student& student : students) {
-        j[STUDENTS_KEY].push_back(studentToJson(student));
+    // Красивое форматирование для отладки, в production используется writeStudents
+    std::string out;
+    writeStudents(students, out, PRETTY_INDENT);
+    return out;
+}
+
+std::string Serializer::serializeStudents(const StudentTable& students) {
+    std::string out;
+    writeStudents(students, out, PRETTY_INDENT);
+    return out;
+}
+
+namespace {
+
+// Ключи пишутся в алфавитном порядке - так же, как их выводит nlohmann::json
+template <typename Row>
+void writeStudentRows(size_t count, std::string& out, int indent, const Row& row) {
+    out.clear();
+    JsonWriter writer(out, indent);
+    writer.beginObject();
+    writer.key("students");
+    writer.beginArray();
+    for (size_t i = 0; i < count; ++i) {
+        row(i, writer);
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+void writeStudentFields(JsonWriter& writer, int id, std::string_view firstName,
+                        std::string_view lastName, Date birthDate) {
+    char date[Date::TEXT_LENGTH];
+    std::string_view dateText;
+    if (birthDate.isValid()) {
+        birthDate.format(date);
+        dateText = std::string_view(date, sizeof(date));
     }
     
-    // Красивое форматирование для отладки, в production можно использовать j.dump()
-    return j.dump(4);
+    writer.beginObject();
+    writer.key("birth_date");
+    writer.value(dateText);
+    writer.key("first_name");
+    writer.value(firstName);
+    writer.key("id");
+    writer.value(static_cast<int64_t>(id));
+    writer.key("last_name");
+    writer.value(lastName);
+    writer.endObject();
 }
 
-std::vector<Student> Serializer::deserializeStudents(const std::string& data) {
-    std::vector<Student> students;
+} // namespace
+
+void Serializer::writeStudents(const std::vector<Student>& students, std::string& out, int indent) {
+    writeStudentRows(students.size(), out, indent, [&students](size_t i, JsonWriter& writer) {
+        const Student& student = students[i];
+        writeStudentFields(writer, student.getId(), student.getFirstName(),
+                           student.getLastName(), student.getBirthDateValue());
+    });
+}
+
+void Serializer::writeStudents(const StudentTable& students, std::string& out, int indent) {
+    writeStudentRows(students.size(), out, indent, [&students](size_t row, JsonWriter& writer) {
+        writeStudentFields(writer, students.id(row), students.firstName(row),
+                           students.lastName(row), students.birthDate(row));
+    });
+}
+
+void Serializer::writeStudents(const std::vector<Student>& students, Format format, std::string& out) {
+    if (format == Format::Binary) {
+        BinarySerializer::serializeStudents(students, out);
+    } else {
+        writeStudents(students, out);
+    }
+}
+
+void Serializer::writeStudents(const StudentTable& students, Format format, std::string& out) {
+    if (format == Format::Binary) {
+        BinarySerializer::serializeStudents(students, out);
+    } else {
+        writeStudents(students, out);
+    }
+}
+
+namespace {
+
+// Событийный (SAX) разбор списка студентов: записи создаются по мере чтения
+// токенов, без построения DOM. Проверки совпадают с validateStudentJson /
+// jsonToStudent, поведение при дублирующихся ключах - как у DOM (побеждает последний)
+template <typename Sink>
+class StudentSaxHandler {
+public:
+    explicit StudentSaxHandler(const Sink& sink)
+        : sink_(sink), depth_(0), topIsObject_(false), studentsKey_(false),
+          studentsSeen_(false), studentsIsArray_(false), inStudents_(false),
+          inRecord_(false), field_(Field::None) {}
+    
+    // Формат проверяется после разбора: ошибка синтаксиса важнее ошибки формата
+    bool hasStudentsArray() const { return topIsObject_ && studentsSeen_ && studentsIsArray_; }
+    
+    bool null() { return scalar(); }
+    bool boolean(bool) { return scalar(); }
+    bool number_float(json::number_float_t, const json::string_t&) { return scalar(); }
+    bool binary(json::binary_t&) { return scalar(); }
     
-    try {
-        json j = json::parse(data);
-        
-        if (!j.contains(STUDENTS_KEY) || !j[STUDENTS_KEY].is_array()) {
-            throw std::invalid_argument("Invalid students JSON format");
+    bool number_integer(json::number_integer_t value) {
+        if (recordField()) {
+            setId(value);
+            return true;
         }
-        
-        for (const nlohmann::json_abi_v3_11_3::json &studentJson : j[STUDENTS_KEY]) {
-            if (validateStudentJson(studentJson)) {
-                students.push_back(jsonToStudent(studentJson));
+        return scalar();
+    }
+    
+    // Число больше INT64_MAX заведомо вне диапазона ID
+    bool number_unsigned(json::number_unsigned_t value) {
+        if (recordField()) {
+            setId(value > static_cast<json::number_unsigned_t>(INT64_MAX) ? -1 : static_cast<int64_t>(value));
+            return true;
+        }
+        return scalar();
+    }
+    
+    bool string(json::string_t& value) {
+        if (recordField()) {
+            FieldState* state = stringField();
+            if (state != nullptr) {
+                state->valid = true;
+                state->value = value;
+            } else {
+                markInvalid();
             }
+            return true;
         }
-    } catch (const json::parse_error& e) {
+        return scalar();
+    }
+    
+    bool start_object(std::size_t) {
+        if (depth_ == 0) {
+            topIsObject_ = true;
+        } else if (depth_ == 1 && studentsKey_) {
+            resetStudents(false);
+        } else if (depth_ == 2 && inStudents_) {
+            beginRecord();
+        } else if (recordField()) {
+            markInvalid();
+        }
+        depth_++;
+        return true;
+    }
+    
+    bool end_object() {
+        depth_--;
+        if (depth_ == 2 && inRecord_) {
+            finishRecord();
+        }
+        return true;
+    }
+    
+    bool start_array(std::size_t) {
+        if (depth_ == 1 && studentsKey_) {
+            resetStudents(true);
+            inStudents_ = true;
+        } else if (recordField()) {
+            markInvalid();
+        }
+        depth_++;
+        return true;
+    }
+    
+    bool end_array() {
+        depth_--;
+        if (depth_ == 1) {
+            inStudents_ = false;
+        }
+        return true;
+    }
+    
+    bool key(json::string_t& name) {
+        if (depth_ == 1) {
+            studentsKey_ = name == "students";
+        } else if (depth_ == 3 && inRecord_) {
+            field_ = fieldFromKey(name);
+        }
+        return true;
+    }
+    
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) {
         throw std::invalid_argument("JSON parse error: " + std::string(e.what()));
     }
     
+private:
+    enum class Field { None, Id, FirstName, LastName, BirthDate };
+    
+    struct FieldState {
+        bool valid = false;
+        std::string value;
+    };
+    
+    static Field fieldFromKey(const std::string& name) {
+        if (name == "id") return Field::Id;
+        if (name == "first_name") return Field::FirstName;
+        if (name == "last_name") return Field::LastName;
+        if (name == "birth_date") return Field::BirthDate;
+        return Field::None;
+    }
+    
+    // Значение поля записи (глубина 3 внутри массива students)
+    bool recordField() const {
+        return depth_ == 3 && inRecord_;
+    }
+    
+    bool scalar() {
+        if (depth_ == 1 && studentsKey_) {
+            resetStudents(false);
+        } else if (recordField()) {
+            markInvalid();
+        }
+        return true;
+    }
+    
+    // Повторный ключ "students" заменяет предыдущее значение, как в DOM
+    void resetStudents(bool isArray) {
+        studentsSeen_ = true;
+        studentsIsArray_ = isArray;
+        sink_.reset();
+    }
+    
+    void beginRecord() {
+        inRecord_ = true;
+        field_ = Field::None;
+        idValid_ = false;
+        firstName_.valid = false;
+        lastName_.valid = false;
+        birthDate_.valid = false;
+    }
+    
+    // Запись с полем неверного типа или не прошедшая Student::isValidRecord
+    // пропускается, как и в двоичном формате
+    void finishRecord() {
+        inRecord_ = false;
+        if (!idValid_ || !firstName_.valid || !lastName_.valid || !birthDate_.valid) {
+            return;
+        }
+        Date birthDate = Date::parse(birthDate_.value);
+        if (Student::isValidRecord(id_, firstName_.value, lastName_.value, birthDate)) {
+            sink_.append(static_cast<int>(id_), firstName_.value, lastName_.value, birthDate);
+        }
+    }
+    
+    void setId(int64_t value) {
+        if (field_ == Field::Id) {
+            id_ = value;
+            idValid_ = true;
+        } else {
+            markInvalid();
+        }
+    }
+    
+    FieldState* stringField() {
+        switch (field_) {
+            case Field::FirstName: return &firstName_;
+            case Field::LastName: return &lastName_;
+            case Field::BirthDate: return &birthDate_;
+            default: return nullptr;
+        }
+    }
+    
+    // Значение неподходящего типа делает поле невалидным (посторонние ключи не важны)
+    void markInvalid() {
+        if (field_ == Field::Id) {
+            idValid_ = false;
+        } else if (FieldState* state = stringField()) {
+            state->valid = false;
+        }
+    }
+    
+private:
+    Sink sink_;
+    int depth_;
+    bool topIsObject_;
+    bool studentsKey_;
+    bool studentsSeen_;
+    bool studentsIsArray_;
+    bool inStudents_;
+    bool inRecord_;
+    Field field_;
+    
+    int64_t id_ = 0;
+    bool idValid_ = false;
+    FieldState firstName_;
+    FieldState lastName_;
+    FieldState birthDate_;
+};
+
+struct StudentVectorSink {
+    std::vector<Student>* students;
+    
+    void reset() { students->clear(); }
+    void append(int id, const std::string& firstName, const std::string& lastName, Date birthDate) {
+        students->emplace_back(id, firstName, lastName, birthDate);
+    }
+};
+
+struct StudentTableSink {
+    StudentTable* table;
+    
+    void reset() { table->clear(); }
+    void append(int id, const std::string& firstName, const std::string& lastName, Date birthDate) {
+        table->append(id, firstName, lastName, birthDate);
+    }
+};
+
+template <typename Sink>
+void parseStudentsSax(const std::string& data, const Sink& sink) {
+    StudentSaxHandler<Sink> handler(sink);
+    json::sax_parse(data, &handler);
+    
+    if (!handler.hasStudentsArray()) {
+        throw std::invalid_argument("Invalid students JSON format");
+    }
+}
+
+} // namespace
+
+std::vector<Student> Serializer::deserializeStudents(const std::string& data) {
+    std::vector<Student> students;
+    parseStudentsSax(data, StudentVectorSink{&students});
     return students;
 }
 
+StudentTable Serializer::deserializeStudentTable(const std::string& data) {
+    StudentTable table;
+    parseStudentsSax(data, StudentTableSink{&table});
+    return table;
+}
+
 bool Serializer::validateStudentJson(const json& j) {
-    return j.contains(ID_KEY) && j[ID_KEY].is_number_integer() &&
-           j.contains(FIRST_NAME_KEY) && j[FIRST_NAME_KEY].is_string() &&
-           j.contains(LAST_NAME_KEY) && j[LAST_NAME_KEY].is_string() &&
-           j.contains(BIRTH_DATE_KEY) && j[BIRTH_DATE_KEY].is_string();
-}
\ No newline at end of file
+    if (!(j.contains(ID_KEY) && j[ID_KEY].is_number_integer() &&
+          j.contains(FIRST_NAME_KEY) && j[FIRST_NAME_KEY].is_string() &&
+          j.contains(LAST_NAME_KEY) && j[LAST_NAME_KEY].is_string() &&
+          j.contains(BIRTH_DATE_KEY) && j[BIRTH_DATE_KEY].is_string())) {
+        return false;
+    }
+    
+    // Значения проверяются так же, как в событийном разборе и двоичном формате
+    const json& id = j[ID_KEY];
+    int64_t value = id.is_number_unsigned() && id.get<uint64_t>() > static_cast<uint64_t>(INT64_MAX)
+        ? -1 : id.get<int64_t>();
+    return Student::isValidRecord(value, j[FIRST_NAME_KEY].get_ref<const std::string&>(),
+                                  j[LAST_NAME_KEY].get_ref<const std::string&>(),
+                                  Date::parse(j[BIRTH_DATE_KEY].get_ref<const std::string&>()));
+}
+Serializer::Format Serializer::detectFormat(const std::string& data) {
+    return BinarySerializer::isBinary(data) ? Format::Binary : Format::Json;
+}
+
+std::string Serializer::serializeStudents(const std::vector<Student>& students, Format format) {
+    std::string out;
+    writeStudents(students, format, out);
+    return out;
+}
+
+std::string Serializer::serializeStudents(const StudentTable& students, Format format) {
+    std::string out;
+    writeStudents(students, format, out);
+    return out;
+}
+
+std::vector<Student> Serializer::decodeStudents(const std::string& data) {
+    if (detectFormat(data) == Format::Binary) {
+        return BinarySerializer::deserializeStudents(data);
+    }
+    return deserializeStudents(data);
+}
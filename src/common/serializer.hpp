@@ -4,12 +4,37 @@
 #include <string>
 #include <vector>
 #include "student.hpp"
+#include "student_table.hpp"
+#include "binary_serializer.hpp"
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
 class Serializer {
 public:
+    // Формат сообщений: JSON или компактный двоичный (BinarySerializer)
+    enum class Format { Json, Binary };
+    
+    // Определение формата по первым байтам сообщения
+    static Format detectFormat(const std::string& data);
+    
+    // Сериализация в выбранном формате (JSON - компактный)
+    static std::string serializeStudents(const std::vector<Student>& students, Format format);
+    static std::string serializeStudents(const StudentTable& students, Format format);
+    
+    // Запись JSON в буфер вызывающего без построения DOM. Содержимое out заменяется,
+    // выделенная память переиспользуется. indent < 0 - компактный JSON
+    static void writeStudents(const std::vector<Student>& students, std::string& out, int indent = -1);
+    static void writeStudents(const StudentTable& students, std::string& out, int indent = -1);
+    
+    // Запись в буфер в выбранном формате (JSON - компактный)
+    static void writeStudents(const std::vector<Student>& students, Format format, std::string& out);
+    static void writeStudents(const StudentTable& students, Format format, std::string& out);
+    
+    // Десериализация с автоматическим определением формата
+    static std::vector<Student> decodeStudents(const std::string& data);
+    
+
     // Сериализация одного студента в JSON
     static json studentToJson(const Student& student);
     
@@ -19,13 +44,22 @@ public:
     // Сериализация списка студентов в JSON строку
     static std::string serializeStudents(const std::vector<Student>& students);
     
+    // Сериализация колоночной таблицы (тот же JSON формат)
+    static std::string serializeStudents(const StudentTable& students);
+    
     // Десериализация JSON строки в список студентов
     static std::vector<Student> deserializeStudents(const std::string& data);
     
-    // Валидация JSON данных
+    // Десериализация JSON строки сразу в колоночную таблицу
+    static StudentTable deserializeStudentTable(const std::string& data);
+    
+    // Валидация записи: типы полей и значения (Student::isValidRecord). Разбор
+    // списков пропускает невалидные записи, двоичный формат - тоже
     static bool validateStudentJson(const json& j);
 
 private:
+    static constexpr int PRETTY_INDENT = 4;
+    
     static const std::string STUDENTS_KEY;
     static const std::string ID_KEY;
     static const std::string FIRST_NAME_KEY;
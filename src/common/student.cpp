@@ -4,26 +4,63 @@
  */
 
 #include "student.hpp"
-#include <cstring>
-#include <iomanip>
+#include <cctype>
+#include <climits>
 #include <sstream>
-#include <chrono>
-#include <iomanip>
 
-Student::Student() : id(0), firstName(""), lastName(""), birthDate("") {
-    std::memset(&birthDateTm, 0, sizeof(birthDateTm));
+namespace {
+
+// Длина символа UTF-8 по первому байту; 0 - недопустимый первый байт
+size_t utf8SequenceLength(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if (lead >= 0xC2 && lead <= 0xDF) return 2;
+    if (lead >= 0xE0 && lead <= 0xEF) return 3;
+    if (lead >= 0xF0 && lead <= 0xF4) return 4;
+    return 0;
 }
 
-Student::Student(int id, const std::string& firstName, const std::string& lastName, const std::string& birthDate) 
-    : id(id), firstName(firstName), lastName(lastName), birthDate(birthDate) {
-    std::memset(&birthDateTm, 0, sizeof(birthDateTm));
-    if (!parseDate(birthDate, birthDateTm)) {
-        this->birthDate = "";
+// Корректный UTF-8: без обрезанных, избыточно длинных последовательностей,
+// суррогатов и кодов больше U+10FFFF
+bool isValidUtf8(std::string_view text) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        unsigned char lead = static_cast<unsigned char>(text[pos]);
+        size_t length = utf8SequenceLength(lead);
+        if (length == 0 || length > text.size() - pos) {
+            return false;
+        }
+        for (size_t i = 1; i < length; ++i) {
+            if ((static_cast<unsigned char>(text[pos + i]) & 0xC0) != 0x80) {
+                return false;
+            }
+        }
+        if (length > 1) {
+            unsigned char second = static_cast<unsigned char>(text[pos + 1]);
+            if ((lead == 0xE0 && second < 0xA0) || (lead == 0xED && second > 0x9F) ||
+                (lead == 0xF0 && second < 0x90) || (lead == 0xF4 && second > 0x8F)) {
+                return false;
+            }
+        }
+        pos += length;
     }
+    return true;
 }
 
-bool Student::validateName(const std::string& name) const {
-    
+} // namespace
+
+Student::Student() : id(0) {
+}
+
+Student::Student(int id, std::string_view firstName, std::string_view lastName, std::string_view birthDate) 
+    : Student(id, firstName, lastName, Date::parse(birthDate)) {
+}
+
+Student::Student(int id, std::string_view firstName, std::string_view lastName, Date birthDate) 
+    : id(id), birthDate(birthDate), lastName(NamePool::global().intern(lastName)),
+      firstName(NamePool::global().intern(firstName)) {
+}
+
+bool Student::isValidName(std::string_view name) {
     for (char c : name) {
         if (!std::isalpha(c) && c != '-' && c != ' ' && c != '.') {
             return false;
@@ -32,48 +69,23 @@ bool Student::validateName(const std::string& name) const {
     return true;
 }
 
-bool Student::parseDate(const std::string& date, std::tm& result) const {
-    std::memset(&result, 0, sizeof(result));
-    
-    int day, month, year;
-    char dot1, dot2;
-    std::istringstream ss(date);
-    
-    if (!(ss >> day >> dot1 >> month >> dot2 >> year)) {
-        return false;
-    }
-    
-    if (dot1 != '.' || dot2 != '.') {
+bool Student::isValidRecordName(std::string_view name) {
+    if (name.empty() || name.size() > MAX_NAME_BYTES) {
         return false;
     }
-    
-    result.tm_mday = day;
-    result.tm_mon = month - 1;
-    result.tm_year = year - 1900;
-    
-    std::tm check = result;
-    std::time_t temp = std::mktime(&check);
-    
-    if (temp == -1) {
-        return false;
-    }
-    
-    if (check.tm_mday != day || check.tm_mon != month - 1 || check.tm_year != year - 1900) {
-        return false;
+    for (char c : name) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (byte < 0x20 || byte == 0x7F) {
+            return false;
+        }
     }
-    
-    return true;
+    return isValidUtf8(name);
 }
 
-bool Student::validateDate(const std::string& date) {
-    std::tm parsedDate;
-    if (parseDate(date, parsedDate)) {
-        birthDateTm = parsedDate;
-        birthDate = date;
-        return true;
-    }
-    
-    return false;
+bool Student::isValidRecord(int64_t id, std::string_view firstName, std::string_view lastName,
+                            Date birthDate) {
+    return id >= 0 && id <= INT_MAX && birthDate.isValid() &&
+           isValidRecordName(lastName) && isValidRecordName(firstName);
 }
 
 bool Student::setId(int newId) {
@@ -84,38 +96,37 @@ bool Student::setId(int newId) {
     return false;
 }
 
-bool Student::setFirstName(const std::string& name) {
-    if (validateName(name) && !name.empty()){
-        firstName = name;
+bool Student::setFirstName(std::string_view name) {
+    if (isValidName(name) && !name.empty()){
+        firstName = NamePool::global().intern(name);
         return true;
     }
     return false;
 }
 
-bool Student::setLastName(const std::string& name) {
-    if (validateName(name) && !name.empty()) {
-        lastName = name;
+bool Student::setLastName(std::string_view name) {
+    if (isValidName(name) && !name.empty()) {
+        lastName = NamePool::global().intern(name);
         return true;
     }
     return false;
 }
 
-bool Student::setBirthDate(const std::string& date) {
-    return validateDate(date);
+bool Student::setBirthDate(std::string_view date) {
+    return Date::parse(date, birthDate);
 }
 
 bool Student::isValid() const {
     return id >= 0 && 
            !firstName.empty() && 
            !lastName.empty() && 
-           !birthDate.empty() &&
-           validateName(firstName) && 
-           validateName(lastName) && 
-           birthDateTm.tm_year != 0;
+           isValidName(firstName.view()) && 
+           isValidName(lastName.view()) && 
+           birthDate.isValid();
 }
 
 bool Student::operator==(const Student& other) const {
-    
+    // Имена интернированы: равные строки имеют один адрес
     return lastName == other.lastName &&
            firstName == other.firstName &&
            birthDate == other.birthDate;
@@ -123,9 +134,9 @@ bool Student::operator==(const Student& other) const {
 
 bool Student::operator<(const Student& other) const {
     if (lastName != other.lastName) {
-        return lastName < other.lastName;
+        return lastName.view() < other.lastName.view();
     }
-    return firstName < other.firstName;
+    return firstName.view() < other.firstName.view();
     
 }
 
@@ -136,9 +147,9 @@ void Student::print() const {
 std::string Student::toString() const {
     std::stringstream ss;
     ss << "ID: " << id 
-       << ", ФИО: " << lastName << " " << firstName;
+       << ", ФИО: " << lastName.view() << " " << firstName.view();
     
-    ss << ", Дата рождения: " << birthDate
+    ss << ", Дата рождения: " << birthDate.toString()
        << " [" << (isValid() ? "VALID" : "INVALID") << "]";
     return ss.str();
 }
\ No newline at end of file
@@ -2,44 +2,57 @@
 #define STUDENT_HPP
 
 #include <string>
+#include <string_view>
 #include <iostream>
-#include <ctime>
-#include <chrono>
-#include <iomanip>
+#include <cstdint>
+#include "name_pool.hpp"
+#include "date.hpp"
 
 class Student {
 private:
     int id;
-    std::string lastName;
-    std::string firstName;
-    std::string birthDate; // format: DD.MM.YYYY
-    std::tm birthDateTm;
-
-
-    bool validateName(const std::string& name) const;
-    bool validateDate(const std::string& date);
-    bool parseDate(const std::string& date, std::tm& result) const;
+    Date birthDate; // вход/выход в формате DD.MM.YYYY
+    InternedName lastName;  // имена хранятся в NamePool::global()
+    InternedName firstName;
 
 public:
     Student();
-    Student(int id, const std::string& firstName, const std::string& lastName,
-            const std::string& birthDate);
+    Student(int id, std::string_view firstName, std::string_view lastName,
+            std::string_view birthDate);
+    Student(int id, std::string_view firstName, std::string_view lastName, Date birthDate);
 
     int getId() const { return id; }
-    std::string getFirstName() const { return firstName; }
-    std::string getLastName() const { return lastName; }
-    std::string getBirthDate() const { return birthDate; }
+    std::string_view getFirstName() const { return firstName.view(); }
+    std::string_view getLastName() const { return lastName.view(); }
+    std::string getBirthDate() const { return birthDate.toString(); }
+    Date getBirthDateValue() const { return birthDate; }
     std::string getFullName() const { 
-        return lastName + firstName;
+        return std::string(lastName.view()) + std::string(firstName.view());
     }
 
+    // Интернированные имена для быстрого сравнения и хэширования
+    const InternedName& getFirstNameHandle() const { return firstName; }
+    const InternedName& getLastNameHandle() const { return lastName; }
+
     bool setId(int newId);
-    bool setFirstName(const std::string& name);
-    bool setLastName(const std::string& name);
-    bool setBirthDate(const std::string& date);
+    bool setFirstName(std::string_view name);
+    bool setLastName(std::string_view name);
+    bool setBirthDate(std::string_view date);
 
     bool isValid() const;
 
+    // Проверка допустимых символов имени без создания объекта
+    static bool isValidName(std::string_view name);
+
+    // Запись из сообщения (JSON или двоичного) проверяется одинаково для обоих
+    // форматов до создания Student и интернирования имён: ID неотрицательный и
+    // помещается в int, имена - непустой корректный UTF-8 без управляющих символов
+    // не длиннее MAX_NAME_BYTES, дата валидна
+    static constexpr size_t MAX_NAME_BYTES = 256;
+    static bool isValidRecordName(std::string_view name);
+    static bool isValidRecord(int64_t id, std::string_view firstName, std::string_view lastName,
+                              Date birthDate);
+
     bool operator==(const Student& other) const; // search for duplicate(FIO + date)
     bool operator<(const Student& other) const;  // sorting by FIO
     
@@ -0,0 +1,167 @@
+/*
+ * Изменения списка студентов между опубликованными версиями
+ * Сервер отправляет только добавленные, удалённые и изменённые записи
+ */
+
+#include "student_delta.hpp"
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+
+// Хэш личности по адресам интернированных имён, как в DataManager
+struct IdentityHash {
+    size_t operator()(const Student& s) const {
+        size_t h = s.getLastNameHandle().hash();
+        h = h * 31 + s.getFirstNameHandle().hash();
+        return h * 31 + std::hash<int32_t>{}(s.getBirthDateValue().daysSinceEpoch());
+    }
+};
+
+// Сравнение строк по ФИО в порядке сортировки Student::operator<
+int compareNames(const StudentTable& a, size_t rowA, const StudentTable& b, size_t rowB) {
+    int result = a.lastName(rowA).compare(b.lastName(rowB));
+    if (result != 0) {
+        return result;
+    }
+    return a.firstName(rowA).compare(b.firstName(rowB));
+}
+
+// Конец группы строк с тем же ФИО, что и у строки begin
+size_t nameGroupEnd(const StudentTable& table, size_t begin) {
+    size_t end = begin + 1;
+    while (end < table.size() && compareNames(table, begin, table, end) == 0) {
+        ++end;
+    }
+    return end;
+}
+
+// Позиция записи с той же личностью в отсортированном списке или students.end()
+std::vector<Student>::iterator findIdentity(std::vector<Student>& students, const Student& student) {
+    auto range = std::equal_range(students.begin(), students.end(), student);
+    auto found = std::find(range.first, range.second, student);
+    return found == range.second ? students.end() : found;
+}
+
+} // namespace
+
+StudentDelta StudentDelta::compute(const StudentTable& previous, const StudentTable& current) {
+    StudentDelta delta;
+    size_t i = 0;
+    size_t j = 0;
+    std::vector<bool> matched;
+
+    while (i < previous.size() || j < current.size()) {
+        int order = 0;
+        if (i == previous.size()) {
+            order = 1;
+        } else if (j == current.size()) {
+            order = -1;
+        } else {
+            order = compareNames(previous, i, current, j);
+        }
+
+        if (order < 0) {
+            delta.removed.push_back(previous.student(i++));
+            continue;
+        }
+        if (order > 0) {
+            delta.added.push_back(current.student(j++));
+            continue;
+        }
+
+        // Одинаковые ФИО: записи сопоставляются по дате рождения (группы малы)
+        size_t previousEnd = nameGroupEnd(previous, i);
+        size_t currentEnd = nameGroupEnd(current, j);
+        matched.assign(previousEnd - i, false);
+
+        for (size_t row = j; row < currentEnd; ++row) {
+            size_t match = previousEnd;
+            for (size_t old = i; old < previousEnd; ++old) {
+                if (!matched[old - i] && previous.birthDate(old) == current.birthDate(row)) {
+                    match = old;
+                    break;
+                }
+            }
+            if (match == previousEnd) {
+                delta.added.push_back(current.student(row));
+                continue;
+            }
+            matched[match - i] = true;
+            if (previous.id(match) != current.id(row)) {
+                delta.modified.push_back(current.student(row));
+            }
+        }
+        for (size_t old = i; old < previousEnd; ++old) {
+            if (!matched[old - i]) {
+                delta.removed.push_back(previous.student(old));
+            }
+        }
+
+        i = previousEnd;
+        j = currentEnd;
+    }
+
+    return delta;
+}
+
+void StudentDelta::apply(std::vector<Student>& students) const {
+    if (size() <= POINT_UPDATE_LIMIT) {
+        // Поиск двоичный, сдвиг вектора только при вставке и удалении
+        for (const Student& student : removed) {
+            auto found = findIdentity(students, student);
+            if (found != students.end()) {
+                students.erase(found);
+            }
+        }
+        for (const Student& student : modified) {
+            auto found = findIdentity(students, student);
+            if (found != students.end()) {
+                *found = student;
+            }
+        }
+        for (const Student& student : added) {
+            students.insert(std::upper_bound(students.begin(), students.end(), student), student);
+        }
+        return;
+    }
+
+    // Один проход: удаление и замена по хэшу личности, затем слияние с добавленными.
+    // Как и при точечном применении, каждая запись изменения затрагивает ровно одну
+    // запись списка: повторы той же личности в списке остаются
+    struct Change {
+        size_t removals = 0;
+        const Student* replacement = nullptr;
+    };
+    std::unordered_map<Student, Change, IdentityHash> changes(removed.size() + modified.size());
+    for (const Student& student : removed) {
+        changes[student].removals++;
+    }
+    for (const Student& student : modified) {
+        changes[student].replacement = &student;
+    }
+
+    std::vector<Student> kept;
+    kept.reserve(students.size());
+    for (const Student& student : students) {
+        auto change = changes.find(student);
+        if (change == changes.end()) {
+            kept.push_back(student);
+        } else if (change->second.removals > 0) {
+            change->second.removals--;
+        } else if (change->second.replacement != nullptr) {
+            kept.push_back(*change->second.replacement);
+            change->second.replacement = nullptr;
+        } else {
+            kept.push_back(student);
+        }
+    }
+
+    std::vector<Student> inserted = added;
+    std::stable_sort(inserted.begin(), inserted.end());
+
+    students.clear();
+    students.reserve(kept.size() + inserted.size());
+    std::merge(kept.begin(), kept.end(), inserted.begin(), inserted.end(), std::back_inserter(students));
+}
@@ -0,0 +1,39 @@
+#ifndef STUDENT_DELTA_HPP
+#define STUDENT_DELTA_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "student.hpp"
+#include "student_table.hpp"
+
+// Изменение опубликованного списка между двумя версиями.
+// Запись определяется личностью (фамилия, имя, дата рождения) - тем же ключом,
+// по которому сервер удаляет дубликаты; у изменённой записи меняется ID.
+struct StudentDelta {
+    uint64_t baseVersion;           // версия, к которой применяется изменение
+    uint64_t version;               // версия после применения
+    std::vector<Student> added;
+    std::vector<Student> removed;
+    std::vector<Student> modified;  // новое значение записи
+
+    StudentDelta() : baseVersion(0), version(0) {}
+
+    size_t size() const { return added.size() + removed.size() + modified.size(); }
+    bool empty() const { return size() == 0; }
+
+    // Разница двух списков, отсортированных по ФИО (как после sortStudentsByName).
+    // Проход слиянием за O(n) без хэш-таблиц
+    static StudentDelta compute(const StudentTable& previous, const StudentTable& current);
+
+    // Применение к списку, отсортированному по ФИО; порядок сохраняется.
+    // Каждая удалённая или изменённая запись затрагивает одну запись списка с той
+    // же личностью, даже если их несколько.
+    // Небольшие изменения вносятся точечно, крупные - одним проходом по списку
+    void apply(std::vector<Student>& students) const;
+
+    // Число изменений, до которого apply вносит их точечно
+    static constexpr size_t POINT_UPDATE_LIMIT = 64;
+};
+
+#endif // STUDENT_DELTA_HPP
@@ -0,0 +1,83 @@
+/*
+ * Разбиение списка студентов на темы для публикации по подпискам
+ */
+
+#include "student_shard.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+
+// Длина первого символа UTF-8 по ведущему байту
+size_t leadingCharLength(std::string_view text) {
+    if (text.empty()) {
+        return 0;
+    }
+    unsigned char lead = static_cast<unsigned char>(text[0]);
+    size_t length = 1;
+    if (lead >= 0xF0) {
+        length = 4;
+    } else if (lead >= 0xE0) {
+        length = 3;
+    } else if (lead >= 0xC0) {
+        length = 2;
+    }
+    return std::min(length, text.size());
+}
+
+} // namespace
+
+bool StudentSharder::parseMode(std::string_view name, Mode& mode) {
+    if (name == "none") {
+        mode = Mode::None;
+    } else if (name == "file") {
+        mode = Mode::SourceFile;
+    } else if (name == "id") {
+        mode = Mode::IdRange;
+    } else if (name == "initial") {
+        mode = Mode::LastNameInitial;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::map<std::string, StudentTable> StudentSharder::shard(const StudentTable& students, Mode mode,
+                                                          int idRange) {
+    std::map<std::string, StudentTable> shards;
+    if (mode != Mode::IdRange && mode != Mode::LastNameInitial) {
+        shards[""] = students;
+        return shards;
+    }
+    for (size_t row = 0; row < students.size(); ++row) {
+        std::string topic = mode == Mode::IdRange ? idRangeTopic(students.id(row), idRange)
+                                                  : initialTopic(students.lastName(row));
+        shards[topic].appendRow(students, row);
+    }
+    return shards;
+}
+
+std::string StudentSharder::fileTopic(const std::string& path) {
+    return "file/" + std::filesystem::path(path).stem().string() + TOPIC_END;
+}
+
+std::string StudentSharder::idRangeTopic(int id, int idRange) {
+    if (idRange <= 0) {
+        idRange = DEFAULT_ID_RANGE;
+    }
+    // Деление с округлением вниз: отрицательные ID тоже попадают в свой диапазон
+    long long start = static_cast<long long>(id) / idRange;
+    if (id < 0 && id % idRange != 0) {
+        start--;
+    }
+    start *= idRange;
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "id/%010lld%c", start, TOPIC_END);
+    return buffer;
+}
+
+std::string StudentSharder::initialTopic(std::string_view lastName) {
+    return "initial/" + std::string(lastName.substr(0, leadingCharLength(lastName))) + TOPIC_END;
+}
@@ -0,0 +1,49 @@
+#ifndef STUDENT_SHARD_HPP
+#define STUDENT_SHARD_HPP
+
+#include <map>
+#include <string>
+#include <string_view>
+#include "student_table.hpp"
+
+// Разбиение опубликованного списка на темы (шарды).
+// Тема - префикс сообщения ZeroMQ: подписчик с фильтром получает только свои
+// шарды, остальные отбрасываются ещё у издателя. Каждая запись попадает ровно
+// в один шард, поэтому объединение шардов совпадает с исходным списком.
+//
+// Темы:
+//   file/<имя файла без расширения>/  - по исходному файлу
+//   id/<начало диапазона>/            - по диапазону ID, начало дополнено нулями
+//                                       до 10 цифр, чтобы фильтр "id/00000" работал
+//   initial/<первая буква фамилии>/   - по первому символу UTF-8 фамилии
+//
+// Тема заканчивается TOPIC_END: ZeroMQ сравнивает подписку с началом темы, и без
+// разделителя подписка "file/student_file_1" получала бы и "file/student_file_10".
+// Подписка на одну тему - её полное имя с разделителем
+class StudentSharder {
+public:
+    enum class Mode {
+        None,
+        SourceFile,
+        IdRange,
+        LastNameInitial
+    };
+
+    static constexpr int DEFAULT_ID_RANGE = 1000;
+    static constexpr char TOPIC_END = '/';
+
+    // Разбор имени режима ("none", "file", "id", "initial"); false, если имя неизвестно
+    static bool parseMode(std::string_view name, Mode& mode);
+
+    // Шарды по свойству записи (IdRange или LastNameInitial); порядок записей
+    // внутри шарда сохраняется, поэтому шарды отсортированного списка отсортированы.
+    // В остальных режимах - один шард с пустой темой
+    static std::map<std::string, StudentTable> shard(const StudentTable& students, Mode mode,
+                                                     int idRange = DEFAULT_ID_RANGE);
+
+    static std::string fileTopic(const std::string& path);
+    static std::string idRangeTopic(int id, int idRange);
+    static std::string initialTopic(std::string_view lastName);
+};
+
+#endif // STUDENT_SHARD_HPP
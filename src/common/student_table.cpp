@@ -0,0 +1,129 @@
+/*
+ * Колоночная таблица студентов для серверного конвейера обработки
+ * Хранит записи в виде плотных массивов вместо вектора объектов Student
+ */
+
+#include "student_table.hpp"
+#include <stdexcept>
+
+StudentTable::StudentTable() : nameOffsets_(1, 0) {
+}
+
+StudentTable::StudentTable(const std::vector<Student>& students) : StudentTable() {
+    reserve(students.size());
+    for (const Student& student : students) {
+        append(student);
+    }
+}
+
+void StudentTable::reserve(size_t rows, size_t nameBytes) {
+    ids_.reserve(rows);
+    birthDates_.reserve(rows);
+    nameOffsets_.reserve(2 * rows + 1);
+    names_.reserve(nameBytes);
+}
+
+void StudentTable::clear() {
+    ids_.clear();
+    birthDates_.clear();
+    nameOffsets_.assign(1, 0);
+    names_.clear();
+}
+
+void StudentTable::append(const Student& student) {
+    append(student.getId(), student.getFirstName(), student.getLastName(), student.getBirthDateValue());
+}
+
+void StudentTable::checkNameBytes(size_t bytes) const {
+    if (bytes > MAX_NAME_BYTES - names_.size()) {
+        throw std::length_error("StudentTable: name buffer exceeds 4 GiB");
+    }
+}
+
+void StudentTable::append(int id, std::string_view firstName, std::string_view lastName, Date birthDate) {
+    // Проверка до изменения колонок, чтобы таблица осталась согласованной
+    checkNameBytes(lastName.size() + firstName.size());
+
+    ids_.push_back(id);
+    birthDates_.push_back(birthDate);
+
+    names_.append(lastName.data(), lastName.size());
+    nameOffsets_.push_back(static_cast<uint32_t>(names_.size()));
+    names_.append(firstName.data(), firstName.size());
+    nameOffsets_.push_back(static_cast<uint32_t>(names_.size()));
+}
+
+void StudentTable::appendRow(const StudentTable& other, size_t row) {
+    // Имена своей строки указывают в буфер, который может переместиться при росте
+    if (&other == this) {
+        std::string lastName(other.lastName(row));
+        std::string firstName(other.firstName(row));
+        append(other.id(row), firstName, lastName, other.birthDate(row));
+        return;
+    }
+    append(other.id(row), other.firstName(row), other.lastName(row), other.birthDate(row));
+}
+
+void StudentTable::appendTable(const StudentTable& other) {
+    // Колонки нельзя вставлять в самих себя: источник копируется
+    if (&other == this) {
+        StudentTable copy(other);
+        appendTable(copy);
+        return;
+    }
+    checkNameBytes(other.names_.size());
+    uint32_t base = static_cast<uint32_t>(names_.size());
+    
+    ids_.insert(ids_.end(), other.ids_.begin(), other.ids_.end());
+    birthDates_.insert(birthDates_.end(), other.birthDates_.begin(), other.birthDates_.end());
+    names_.append(other.names_);
+    
+    // Первое смещение другой таблицы (0) совпадает с нашим последним
+    nameOffsets_.reserve(nameOffsets_.size() + other.nameOffsets_.size() - 1);
+    for (size_t i = 1; i < other.nameOffsets_.size(); ++i) {
+        nameOffsets_.push_back(base + other.nameOffsets_[i]);
+    }
+}
+
+std::string_view StudentTable::lastName(size_t row) const {
+    uint32_t begin = nameOffsets_[2 * row];
+    uint32_t end = nameOffsets_[2 * row + 1];
+    return std::string_view(names_.data() + begin, end - begin);
+}
+
+std::string_view StudentTable::firstName(size_t row) const {
+    uint32_t begin = nameOffsets_[2 * row + 1];
+    uint32_t end = nameOffsets_[2 * row + 2];
+    return std::string_view(names_.data() + begin, end - begin);
+}
+
+bool StudentTable::isValidRow(size_t row) const {
+    std::string_view last = lastName(row);
+    std::string_view first = firstName(row);
+    return ids_[row] >= 0 &&
+           !last.empty() && !first.empty() &&
+           Student::isValidName(last) && Student::isValidName(first) &&
+           birthDates_[row].isValid();
+}
+
+Student StudentTable::student(size_t row) const {
+    return Student(ids_[row], firstName(row), lastName(row), birthDate(row));
+}
+
+std::vector<Student> StudentTable::toStudents() const {
+    std::vector<Student> students;
+    students.reserve(size());
+    for (size_t row = 0; row < size(); ++row) {
+        students.push_back(student(row));
+    }
+    return students;
+}
+
+StudentTable StudentTable::select(const std::vector<size_t>& rows) const {
+    StudentTable result;
+    result.reserve(rows.size());
+    for (size_t row : rows) {
+        result.appendRow(*this, row);
+    }
+    return result;
+}
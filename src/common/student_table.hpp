@@ -0,0 +1,61 @@
+#ifndef STUDENT_TABLE_HPP
+#define STUDENT_TABLE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "student.hpp"
+#include "date.hpp"
+
+// Колоночное (structure-of-arrays) хранилище студентов.
+// Каждое поле лежит в своём плотном массиве: ID, дата рождения (Date, 32 бита),
+// смещения имён и общий буфер с символами фамилий и имён.
+class StudentTable {
+public:
+    // Смещения имён 32-битные, поэтому буфер имён ограничен 4 ГиБ
+    static constexpr size_t MAX_NAME_BYTES = std::numeric_limits<uint32_t>::max();
+
+    StudentTable();
+    explicit StudentTable(const std::vector<Student>& students);
+
+    // Размер и управление памятью
+    size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+    void reserve(size_t rows, size_t nameBytes = 0);
+    void clear();
+
+    // Добавление строк
+    void append(const Student& student);
+    void append(int id, std::string_view firstName, std::string_view lastName, Date birthDate);
+    void appendRow(const StudentTable& other, size_t row);
+    void appendTable(const StudentTable& other);
+
+    // Доступ к колонкам
+    int id(size_t row) const { return ids_[row]; }
+    std::string_view lastName(size_t row) const;
+    std::string_view firstName(size_t row) const;
+    Date birthDate(size_t row) const { return birthDates_[row]; }
+
+    bool isValidRow(size_t row) const;
+
+    // Преобразование в объекты Student
+    Student student(size_t row) const;
+    std::vector<Student> toStudents() const;
+
+    // Новая таблица из выбранных строк (в указанном порядке)
+    StudentTable select(const std::vector<size_t>& rows) const;
+
+private:
+    // Бросает std::length_error, если буфер имён не вместит ещё bytes байт
+    void checkNameBytes(size_t bytes) const;
+
+    std::vector<int32_t> ids_;
+    std::vector<Date> birthDates_;
+    // Для строки i: фамилия в [2i, 2i+1), имя в [2i+1, 2i+2)
+    std::vector<uint32_t> nameOffsets_;
+    std::string names_;
+};
+
+#endif // STUDENT_TABLE_HPP
@@ -6,17 +6,35 @@
 #include "zmq_publisher.hpp"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
-ZmqPublisher::ZmqPublisher() 
-    : running_(false), stop_requested_(false), 
-      messages_sent_(0), students_sent_(0) {
+namespace {
+
+// Снимок для запросов: ZeroMQ держит ссылку, пока сообщение не отправлено
+void releaseSharedReply(void*, void* hint) {
+    delete static_cast<std::shared_ptr<const std::string>*>(hint);
+}
+
+} // namespace
+
+ZmqPublisher::ZmqPublisher(size_t queue_capacity) 
+    : running_(false), stop_requested_(false), message_queue_(queue_capacity),
+      buffer_pool_(std::make_shared<BufferPool>()), policy_(BackpressurePolicy::Block),
+      delta_threshold_(DEFAULT_DELTA_THRESHOLD),
+      snapshot_chunk_size_(DEFAULT_SNAPSHOT_CHUNK_SIZE),
+      messages_sent_(0), students_sent_(0), snapshots_sent_(0), snapshot_chunks_sent_(0),
+      deltas_sent_(0),
+      fail_next_reply_(false),
+      snapshot_requests_(0), snapshot_restarts_(0), messages_dropped_(0),
+      bytes_before_compression_(0), bytes_after_compression_(0),
+      format_(Serializer::Format::Json) {
 }
 
 ZmqPublisher::~ZmqPublisher() {
     stop();
 }
 
-bool ZmqPublisher::start(const std::string& endpoint) {
+bool ZmqPublisher::start(const std::string& endpoint, const std::string& snapshot_endpoint) {
     if (running_) {
         std::cerr << "Publisher already running" << std::endl;
         return false;
@@ -29,41 +47,91 @@ bool ZmqPublisher::start(const std::string& endpoint) {
         
         // Настройка socket
         socket_->set(zmq::sockopt::linger, 0);
-        socket_->set(zmq::sockopt::sndhwm, 1000);
+        socket_->set(zmq::sockopt::sndhwm, SEND_HWM);
+        // Отправка не ждёт подписчиков: у подписчика, упёршегося в sndhwm, ZeroMQ
+        // отбрасывает сообщения только для него. Остальные получают всё, а
+        // отставший видит разрыв цепочки версий и запрашивает снимок.
+        // С xpub_nodrop один остановившийся подписчик задержал бы всех
         
         // Привязка к endpoint
         socket_->bind(endpoint);
         
         std::cout << "ZMQ Publisher started on " << endpoint << std::endl;
         
+        // Сервис снимков для подписчиков, подключившихся позже
+        snapshot_endpoint_ = snapshot_endpoint;
+        if (!snapshot_endpoint.empty()) {
+            snapshot_socket_ = openSnapshotSocket();
+            // Контекст у каждого издателя свой, поэтому имя inproc не пересекается
+            control_receiver_ = std::make_unique<zmq::socket_t>(*context_, ZMQ_PAIR);
+            control_receiver_->bind(CONTROL_ENDPOINT);
+            control_sender_ = std::make_unique<zmq::socket_t>(*context_, ZMQ_PAIR);
+            control_sender_->set(zmq::sockopt::linger, 0);
+            control_sender_->connect(CONTROL_ENDPOINT);
+            std::cout << "ZMQ snapshot service started on " << snapshot_endpoint << std::endl;
+        }
+        
         running_ = true;
         stop_requested_ = false;
         worker_thread_ = std::thread(&ZmqPublisher::run, this);
+        if (!snapshot_endpoint.empty()) {
+            snapshot_thread_ = std::thread(&ZmqPublisher::runSnapshotService, this);
+        }
         
         return true;
     } catch (const zmq::error_t& e) {
         std::cerr << "ZMQ Publisher error: " << e.what() << std::endl;
+        closeSockets();
         return false;
     }
 }
 
+void ZmqPublisher::closeSockets() {
+    // Сокеты закрываются до контекста; указатели сбрасываются, чтобы следующий
+    // start не увидел закрытых сокетов прошлого запуска
+    control_sender_.reset();
+    control_receiver_.reset();
+    snapshot_socket_.reset();
+    socket_.reset();
+    if (context_) {
+        context_->close();
+        context_.reset();
+    }
+}
+
 void ZmqPublisher::stop() {
     if (!running_) return;
     
     stop_requested_ = true;
-    queue_cv_.notify_all();
+    message_queue_.wakeAll();
+    if (control_sender_) {
+        try {
+            control_sender_->send(zmq::message_t(), zmq::send_flags::dontwait);
+        } catch (const zmq::error_t& e) {
+            std::cerr << "Publisher control error: " << e.what() << std::endl;
+        }
+    }
     
     if (worker_thread_.joinable()) {
         worker_thread_.join();
     }
-    
-    if (socket_) {
-        socket_->close();
+    if (snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
     }
+    closeSockets();
     
-    if (context_) {
-        context_->close();
+    // Цепочки версий принадлежали закрытому сокету: подписчики нового запуска
+    // начинают со снимка
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        streams_.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(forced_mutex_);
+        forced_topics_.clear();
     }
+    snapshot_endpoint_.clear();
+    fail_next_reply_ = false;
     
     running_ = false;
     std::cout << "ZMQ Publisher stopped" << std::endl;
@@ -75,65 +143,488 @@ void ZmqPublisher::publish(const std::vector<Student>& students) {
         return;
     }
     
-    std::string message = Serializer::serializeStudents(students);
-    publish(message);
+    // Сериализация сразу в буфер, который затем перемещается в очередь без копирования
+    std::string message = buffer_pool_->take();
+    Serializer::writeStudents(students, format_, message);
+    publish(std::move(message));
     students_sent_ += students.size();
 }
 
+void ZmqPublisher::publish(const StudentTable& students) {
+    if (!running_) {
+        std::cerr << "Publisher not running" << std::endl;
+        return;
+    }
+    
+    // Сериализация сразу в буфер, который затем перемещается в очередь без копирования
+    std::string message = buffer_pool_->take();
+    Serializer::writeStudents(students, format_, message);
+    publish(std::move(message));
+    students_sent_ += students.size();
+}
+
+void ZmqPublisher::publishUpdate(const StudentTable& students) {
+    if (!running_) {
+        std::cerr << "Publisher not running" << std::endl;
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    // При конфляции неотправленные версии заменяются новой; вытесненные
+    // темы получат снимок, изменение от вытесненной версии не применить
+    if (policy_ == BackpressurePolicy::KeepLatest) {
+        while (dropOldest()) {
+        }
+    }
+    publishStream("", students);
+}
+
+void ZmqPublisher::publishDelta(const StudentDelta& changes) {
+    if (!running_) {
+        std::cerr << "Publisher not running" << std::endl;
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    if (policy_ == BackpressurePolicy::KeepLatest) {
+        while (dropOldest()) {
+        }
+    }
+    
+    TopicStream& stream = streams_[""];
+    bool forced = takeForcedSnapshot("");
+    bool sendSnapshot = stream.version == 0 || forced || format_ != Serializer::Format::Binary;
+    if (!sendSnapshot && changes.empty()) {
+        return;
+    }
+    
+    stream.size = stream.size + changes.added.size() - changes.removed.size();
+    stream.pending.push_back(changes);
+    stream.pendingRecords += changes.size();
+    sendSnapshot = sendSnapshot || changes.size() > stream.size * delta_threshold_;
+    // Копия списка догоняет изменения, когда их накопилось столько же, сколько
+    // оправдывает снимок: сборка O(n) приходится на O(n · порог) изменений
+    if (sendSnapshot || stream.pendingRecords > stream.size * delta_threshold_) {
+        applyPending(stream);
+    }
+    
+    StudentDelta delta = changes;
+    sendVersion("", stream, delta, sendSnapshot);
+}
+
+void ZmqPublisher::applyPending(TopicStream& stream) {
+    if (stream.pending.empty()) {
+        return;
+    }
+    std::vector<Student> students = stream.last.toStudents();
+    for (const StudentDelta& delta : stream.pending) {
+        delta.apply(students);
+    }
+    stream.last = StudentTable(students);
+    stream.pending.clear();
+    stream.pendingRecords = 0;
+}
+
+void ZmqPublisher::publishShards(const std::map<std::string, StudentTable>& shards) {
+    if (!running_) {
+        std::cerr << "Publisher not running" << std::endl;
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    if (policy_ == BackpressurePolicy::KeepLatest) {
+        while (dropOldest()) {
+        }
+    }
+    
+    for (const auto& shard : shards) {
+        publishStream(shard.first, shard.second);
+    }
+    
+    // Исчезнувшая тема очищается у подписчиков
+    const StudentTable empty;
+    for (const auto& stream : streams_) {
+        if (stream.second.size != 0 && shards.find(stream.first) == shards.end()) {
+            publishStream(stream.first, empty);
+        }
+    }
+}
+
+void ZmqPublisher::publishStream(const std::string& topic, const StudentTable& students) {
+    TopicStream& stream = streams_[topic];
+    applyPending(stream);
+    
+    // JSON-клиенты умеют только заменять список целиком. После вытеснения
+    // версии из очереди цепочка изменений восстанавливается снимком
+    bool forced = takeForcedSnapshot(topic);
+    bool sendSnapshot = stream.version == 0 || forced || format_ != Serializer::Format::Binary;
+    StudentDelta delta;
+    if (!sendSnapshot) {
+        delta = StudentDelta::compute(stream.last, students);
+        if (delta.empty()) {
+            return;
+        }
+        sendSnapshot = delta.size() > students.size() * delta_threshold_;
+    }
+    
+    stream.last = students;
+    stream.size = students.size();
+    sendVersion(topic, stream, delta, sendSnapshot);
+}
+
+void ZmqPublisher::sendVersion(const std::string& topic, TopicStream& stream, StudentDelta& delta,
+                               bool sendSnapshot) {
+    const StudentTable& students = stream.last;
+    uint64_t version = stream.version + 1;
+    std::string message = buffer_pool_->take();
+    
+    size_t chunk = snapshot_chunk_size_;
+    bool chunked = sendSnapshot && format_ == Serializer::Format::Binary && chunk > 0 &&
+                   students.size() > chunk;
+    
+    if (sendSnapshot) {
+        // Части большого снимка сериализуются по одной при отправке
+        if (!chunked && format_ == Serializer::Format::Binary) {
+            BinarySerializer::serializeStudents(students, message, version);
+            compressMessage(message);
+        } else if (!chunked) {
+            Serializer::writeStudents(students, message);
+        }
+        students_sent_ += students.size();
+        snapshots_sent_++;
+    } else {
+        delta.baseVersion = stream.version;
+        delta.version = version;
+        BinarySerializer::serializeDelta(delta, message);
+        compressMessage(message);
+        students_sent_ += delta.size();
+        deltas_sent_++;
+    }
+    
+    stream.version = version;
+    if (chunked) {
+        buffer_pool_->recycle(std::move(message));
+        publishChunks(topic, students, version);
+    } else {
+        enqueue(QueuedMessage{topic, std::move(message)}, false);
+    }
+}
+
+void ZmqPublisher::publishChunks(const std::string& topic, const StudentTable& students,
+                                 uint64_t version) {
+    size_t chunk = snapshot_chunk_size_;
+    size_t count = (students.size() + chunk - 1) / chunk;
+    
+    // Части сериализуются по одной: в памяти не больше очереди готовых частей
+    for (size_t index = 0; index < count; ++index) {
+        size_t begin = index * chunk;
+        size_t end = std::min(begin + chunk, students.size());
+        std::string message = buffer_pool_->take();
+        BinarySerializer::serializeSnapshotChunk(students, begin, end, version, index, count, message);
+        compressMessage(message);
+        enqueue(QueuedMessage{topic, std::move(message)}, false);
+        snapshot_chunks_sent_++;
+    }
+}
+
+void ZmqPublisher::setCodec(std::shared_ptr<const PayloadCodec> codec) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    codec_ = std::move(codec);
+    // Снимки для запросов пересобираются с новым кодеком
+    for (auto& stream : streams_) {
+        stream.second.reply.reset();
+    }
+}
+
+std::shared_ptr<const PayloadCodec> ZmqPublisher::getCodec() const {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    return codec_;
+}
+
+void ZmqPublisher::compressMessage(std::string& message) {
+    if (!codec_) {
+        return;
+    }
+    // Несжимаемое сообщение уходит как есть: подписчик различает их по флагу заголовка
+    std::string compressed = buffer_pool_->take();
+    if (codec_->compress(message, compressed)) {
+        bytes_before_compression_ += message.size();
+        bytes_after_compression_ += compressed.size();
+        message.swap(compressed);
+    }
+    buffer_pool_->recycle(std::move(compressed));
+}
+
+uint64_t ZmqPublisher::getVersion(const std::string& topic) const {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    auto it = streams_.find(topic);
+    return it != streams_.end() ? it->second.version : 0;
+}
+
+size_t ZmqPublisher::getTopicCount() const {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    return streams_.size();
+}
+
 void ZmqPublisher::publish(const std::string& message) {
+    publish(std::string(message));
+}
+
+void ZmqPublisher::publish(std::string&& message) {
+    enqueue(QueuedMessage{std::string(), std::move(message)}, true);
+}
+
+void ZmqPublisher::enqueue(QueuedMessage&& message, bool supersedes) {
     if (!running_) return;
     
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        message_queue_.push(message);
+    switch (policy_.load()) {
+    case BackpressurePolicy::Block:
+        // Запись без блокировок; ожидание только при заполненной очереди
+        if (!message_queue_.push(std::move(message), stop_requested_)) {
+            messages_dropped_++;
+            std::cerr << "Publisher stopping, message dropped" << std::endl;
+        }
+        return;
+    case BackpressurePolicy::KeepLatest:
+        // Всё, что ещё не отправлено, устарело
+        while (supersedes && dropOldest()) {
+        }
+        break;
+    case BackpressurePolicy::DropOldest:
+        break;
     }
     
-    queue_cv_.notify_one();
+    while (!message_queue_.tryPush(std::move(message))) {
+        dropOldest();
+    }
 }
 
-size_t ZmqPublisher::getQueueSize() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return message_queue_.size();
+bool ZmqPublisher::dropOldest() {
+    QueuedMessage dropped;
+    if (!message_queue_.tryEvict(dropped)) {
+        return false;
+    }
+    
+    // Потеряна версия темы: следующие изменения подписчикам не применить
+    BinarySerializer::Header header;
+    if (BinarySerializer::readHeader(dropped.body, header)) {
+        std::lock_guard<std::mutex> lock(forced_mutex_);
+        forced_topics_.insert(dropped.topic);
+    }
+    messages_dropped_++;
+    buffer_pool_->recycle(std::move(dropped.body));
+    return true;
+}
+
+bool ZmqPublisher::takeForcedSnapshot(const std::string& topic) {
+    std::lock_guard<std::mutex> lock(forced_mutex_);
+    return forced_topics_.erase(topic) > 0;
+}
+
+std::string ZmqPublisher::BufferPool::take() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spare.empty()) {
+        return std::string();
+    }
+    std::string buffer = std::move(spare.back());
+    spare.pop_back();
+    return buffer;
+}
+
+void ZmqPublisher::BufferPool::recycle(std::string&& buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spare.size() < MAX_SPARE_BUFFERS) {
+        buffer.clear();
+        spare.push_back(std::move(buffer));
+    }
+}
+
+void ZmqPublisher::releaseBuffer(void*, void* hint) {
+    std::unique_ptr<OwnedBuffer> owned(static_cast<OwnedBuffer*>(hint));
+    owned->pool->recycle(std::move(owned->data));
 }
 
 void ZmqPublisher::run() {
-    while (!stop_requested_ || !message_queue_.empty()) {
-        std::string message;
-        
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            if (message_queue_.empty()) {
-                queue_cv_.wait_for(lock, std::chrono::milliseconds(100));
-                continue;
+    QueuedMessage message;
+    while (true) {
+        // Перед остановкой очередь дочитывается до конца
+        if (!message_queue_.tryPop(message)) {
+            if (stop_requested_) {
+                break;
             }
-            
-            message = message_queue_.front();
-            message_queue_.pop();
+            message_queue_.waitForData(stop_requested_);
+            continue;
         }
         
-        if (sendMessage(message)) {
+        // Буфер передаётся ZeroMQ и вернётся в пул после отправки
+        if (sendMessage(std::move(message))) {
             messages_sent_++;
         } else {
-            std::cerr << "Failed to send message" << std::endl;
+            messages_dropped_++;
+            if (!stop_requested_) {
+                std::cerr << "Failed to send message" << std::endl;
+            }
+        }
+    }
+}
+
+
+
+void ZmqPublisher::runSnapshotService() {
+    while (!stop_requested_) {
+        try {
+            // Поток спит до запроса или сигнала остановки. Сокет после сбоя
+            // пересоздаётся, поэтому набор опроса строится на каждой итерации
+            zmq::pollitem_t items[] = {
+                {snapshot_socket_->handle(), 0, ZMQ_POLLIN, 0},
+                {control_receiver_->handle(), 0, ZMQ_POLLIN, 0}
+            };
+            zmq::poll(items, 2);
+            if (items[1].revents & ZMQ_POLLIN) {
+                break;
+            }
+            zmq::message_t request;
+            if (!(items[0].revents & ZMQ_POLLIN) ||
+                !snapshot_socket_->recv(request, zmq::recv_flags::dontwait)) {
+                continue;
+            }
+            
+            // Второй кадр запроса - префикс тем; без него - все темы
+            std::string command = request.to_string();
+            std::string filter;
+            while (request.more()) {
+                snapshot_socket_->recv(request);
+                filter = request.to_string();
+            }
+            if (command == CODEC_REQUEST) {
+                sendCodecReply();
+                continue;
+            }
+            sendSnapshotReply(filter);
+            snapshot_requests_++;
+        } catch (const zmq::error_t& e) {
+            // После сбоя посреди запроса или ответа REP остаётся в состоянии, где
+            // любые recv и send сразу завершаются ошибкой EFSM: сокет пересоздаётся
+            std::cerr << "Snapshot service error: " << e.what() << std::endl;
+            restartSnapshotSocket();
+        }
+    }
+}
+
+std::unique_ptr<zmq::socket_t> ZmqPublisher::openSnapshotSocket() {
+    auto socket = std::make_unique<zmq::socket_t>(*context_, ZMQ_REP);
+    socket->set(zmq::sockopt::linger, 0);
+    socket->bind(snapshot_endpoint_);
+    return socket;
+}
+
+void ZmqPublisher::restartSnapshotSocket() {
+    snapshot_socket_->close();
+    snapshot_restarts_++;
+    
+    // Пауза перед каждой попыткой: порт освобождается асинхронно, и повторяющийся
+    // сбой не занимает процессор. Паузу прерывает сигнал остановки; он остаётся
+    // непрочитанным и завершает основной цикл сервиса
+    zmq::pollitem_t control = {control_receiver_->handle(), 0, ZMQ_POLLIN, 0};
+    while (!stop_requested_) {
+        try {
+            zmq::poll(&control, 1, std::chrono::milliseconds(SNAPSHOT_RETRY_MS));
+            if (control.revents & ZMQ_POLLIN) {
+                return;
+            }
+            snapshot_socket_ = openSnapshotSocket();
+            return;
+        } catch (const zmq::error_t& e) {
+            std::cerr << "Snapshot service restart error: " << e.what() << std::endl;
         }
     }
 }
 
+void ZmqPublisher::sendSnapshotReply(const std::string& filter) {
+    // Обрыв посреди ответа: recv у REP в состоянии отправки завершается EFSM
+    if (fail_next_reply_.exchange(false)) {
+        snapshot_socket_->send(zmq::message_t(), zmq::send_flags::sndmore);
+        zmq::message_t unexpected;
+        snapshot_socket_->recv(unexpected);
+    }
+    
+    std::vector<std::pair<std::string, std::shared_ptr<const std::string>>> replies;
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        for (auto& stream : streams_) {
+            if (stream.second.version != 0 && stream.first.compare(0, filter.size(), filter) == 0) {
+                replies.emplace_back(stream.first, buildSnapshotReply(stream.second));
+            }
+        }
+    }
+    
+    // Данных ещё нет: REP обязан ответить хотя бы одним кадром
+    if (replies.empty()) {
+        snapshot_socket_->send(zmq::message_t());
+        return;
+    }
+    
+    for (size_t i = 0; i < replies.size(); ++i) {
+        bool last = i + 1 == replies.size();
+        snapshot_socket_->send(zmq::buffer(replies[i].first), zmq::send_flags::sndmore);
+        
+        // Сообщение ссылается на общий буфер снимка; ссылка освобождается после отправки
+        const std::shared_ptr<const std::string>& reply = replies[i].second;
+        std::unique_ptr<std::shared_ptr<const std::string>> hint(
+            new std::shared_ptr<const std::string>(reply));
+        zmq::message_t message(const_cast<char*>(reply->data()), reply->size(),
+                               releaseSharedReply, hint.get());
+        hint.release();
+        snapshot_socket_->send(message, last ? zmq::send_flags::none : zmq::send_flags::sndmore);
+    }
+}
+
+void ZmqPublisher::sendCodecReply() {
+    std::shared_ptr<const PayloadCodec> codec = getCodec();
+    std::string name = codec ? "zstd" : "none";
+    snapshot_socket_->send(zmq::buffer(name), zmq::send_flags::sndmore);
+    if (codec) {
+        snapshot_socket_->send(zmq::buffer(codec->dictionary()));
+    } else {
+        snapshot_socket_->send(zmq::message_t());
+    }
+}
 
+std::shared_ptr<const std::string> ZmqPublisher::buildSnapshotReply(TopicStream& stream) {
+    // Вызывается под update_mutex_: версия снимка согласована с потоком, изменения
+    // после неё ещё не отправлены или будут отброшены подписчиком как уже учтённые.
+    // Отправляемый буфер не изменяется: для новой версии строится новый
+    if (!stream.reply || stream.replyVersion != stream.version) {
+        applyPending(stream);
+        auto reply = std::make_shared<std::string>();
+        BinarySerializer::serializeStudents(stream.last, *reply, stream.version);
+        compressMessage(*reply);
+        stream.reply = std::move(reply);
+        stream.replyVersion = stream.version;
+    }
+    return stream.reply;
+}
 
-bool ZmqPublisher::sendMessage(const std::string& message) {
+bool ZmqPublisher::sendMessage(QueuedMessage&& message) {
     if (!socket_ || !context_) {
         std::cerr << "Socket is not initialized" << std::endl;
-        std::cout << "Отправка сообщения длиной " << message.length() << " байт" << std::endl;
+        std::cout << "Отправка сообщения длиной " << message.body.length() << " байт" << std::endl;
         return false;
     }
     try {
-        zmq::message_t zmq_message(message.size());
-        memcpy(zmq_message.data(), message.c_str(), message.size());
-        zmq::send_result_t result = socket_->send(zmq_message, zmq::send_flags::dontwait);
+        // Кадр темы, по которому подписчики фильтруют сообщения
+        if (!message.topic.empty()) {
+            zmq::message_t topic(message.topic.data(), message.topic.size());
+            if (!socket_->send(topic, zmq::send_flags::sndmore)) {
+                return false;
+            }
+        }
         
-        // Простое преобразование в bool
-        return static_cast<bool>(result);
+        // Без копирования: ZeroMQ забирает буфер и освобождает его через releaseBuffer
+        std::unique_ptr<OwnedBuffer> owned(new OwnedBuffer{std::move(message.body), buffer_pool_});
+        zmq::message_t body(&owned->data[0], owned->data.size(), releaseBuffer, owned.get());
+        owned.release();
+        return socket_->send(body, zmq::send_flags::none).has_value();
     } catch (const zmq::error_t& e) {
         std::cerr << "ZeroMQ send error: " << e.what() << std::endl;
         return false;
@@ -5,55 +5,244 @@
 #include <vector>
 #include <thread>
 #include <atomic>
-#include <queue>
 #include <mutex>
-#include <condition_variable>
+#include <memory>
+#include <map>
+#include <set>
 #include <zmq.hpp>
 #include "student.hpp"
 #include "serializer.hpp"
+#include "student_delta.hpp"
+#include "mpsc_ring.hpp"
+#include "payload_codec.hpp"
 
 class ZmqPublisher {
 public:
-    ZmqPublisher();
+    using QueueStats = MpscRingStats;
+    
+    // Поведение publish, когда очередь заполнена медленными подписчиками
+    enum class BackpressurePolicy {
+        Block,       // ждать, пока поток отправки освободит место
+        DropOldest,  // вытеснить самое старое сообщение
+        KeepLatest   // оставить в очереди только новое сообщение (конфляция)
+    };
+    
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1024;
+    
+    // Очередь сообщений ограничена ёмкостью, а ZeroMQ - sndhwm на подписчика,
+    // поэтому память издателя не растёт при медленных подписчиках. Сообщения
+    // сверх sndhwm подписчика теряются только для него: остальных он не задерживает
+    explicit ZmqPublisher(size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
     ~ZmqPublisher();
     
-    // Запуск и остановка publisher
-    bool start(const std::string& endpoint = "tcp://*:5556");
+    // Запуск и остановка publisher. Если задан snapshot_endpoint, рядом с PUB
+    // поднимается REP-сокет. Запрос: кадр "SNAPSHOT" и необязательный кадр
+    // с префиксом тем. Ответ: пары кадров (тема, двоичный снимок последней версии)
+    // для всех опубликованных тем с этим префиксом или один пустой кадр, если
+    // данных ещё нет. Список из publishUpdate отвечает на пустую тему.
+    // Запрос "CODEC": ответ - имя кодека ("zstd" или "none") и словарь.
+    // stop закрывает сокеты и сбрасывает версии тем: следующий start начинает
+    // цепочки заново
+    bool start(const std::string& endpoint = "tcp://*:5556",
+               const std::string& snapshot_endpoint = "");
     void stop();
     
+    // Формат сериализации списков студентов (по умолчанию JSON)
+    void setFormat(Serializer::Format format) { format_ = format; }
+    Serializer::Format getFormat() const { return format_; }
+    
+    // Политика заполненной очереди (по умолчанию Block). Вытесненное изменение
+    // рвёт цепочку версий темы, поэтому следующая публикация темы - снимок
+    void setBackpressurePolicy(BackpressurePolicy policy) { policy_ = policy; }
+    BackpressurePolicy getBackpressurePolicy() const { return policy_; }
+    
     // Отправка данных
     void publish(const std::vector<Student>& students);
+    void publish(const StudentTable& students);
     void publish(const std::string& message);
+    void publish(std::string&& message);
+    
+    // Публикация новой версии списка (отсортированного по ФИО): отправляется
+    // изменение относительно предыдущей версии или полный снимок, если изменение
+    // больше порога. Изменения передаются только в двоичном формате
+    void publishUpdate(const StudentTable& students);
+    
+    // То же для списка, который хранит вызывающий: передаётся только изменение
+    // относительно предыдущей публикации (первое - относительно пустого списка),
+    // версии заполняются здесь. Не требует полного списка и сравнения с ним:
+    // полная копия собирается из накопленных изменений только для снимка
+    void publishDelta(const StudentDelta& changes);
+    
+    // Публикация нового состояния по темам (шардам, см. StudentSharder). У каждой
+    // темы своя цепочка версий; сообщение уходит двумя кадрами (тема, тело), и
+    // ZeroMQ отбрасывает ненужные подписчику темы ещё у издателя. Тема из прошлой
+    // публикации, которой нет в shards, публикуется пустой
+    void publishShards(const std::map<std::string, StudentTable>& shards);
+    
+    // Доля изменённых записей от размера списка, выше которой отправляется снимок
+    void setDeltaThreshold(double fraction) { delta_threshold_ = fraction; }
+    double getDeltaThreshold() const { return delta_threshold_; }
+    
+    // Снимок больше chunk записей отправляется частями по chunk записей: подписчик
+    // разбирает часть, пока передаются следующие, и ни одна сторона не держит
+    // весь снимок одним буфером. 0 - всегда одним сообщением
+    void setSnapshotChunkSize(size_t records) { snapshot_chunk_size_ = records; }
+    size_t getSnapshotChunkSize() const { return snapshot_chunk_size_; }
+    
+    // Сжатие двоичных сообщений и снимков по запросу (nullptr - без сжатия).
+    // Кодек задаётся для издателя, то есть для его конечной точки: медленным
+    // каналам можно отдать отдельный издатель со сжатием. Подписчик узнаёт кодек
+    // и словарь у сервиса снимков, поэтому сжатие требует snapshot_endpoint
+    void setCodec(std::shared_ptr<const PayloadCodec> codec);
+    std::shared_ptr<const PayloadCodec> getCodec() const;
+    
+    // Версия темы; пустая тема - список из publishUpdate
+    uint64_t getVersion(const std::string& topic = "") const;
+    size_t getTopicCount() const;
     
     // Статус
     bool isRunning() const { return running_; }
-    size_t getQueueSize() const;
+    size_t getQueueSize() const { return message_queue_.size(); }
+    size_t getQueueCapacity() const { return message_queue_.capacity(); }
+    
+    // Конкуренция производителей, ожидания места, засыпания потока отправки
+    // и наибольшая глубина очереди
+    QueueStats getQueueStats() const { return message_queue_.stats(); }
     
     // Статистика
     size_t getMessagesSent() const { return messages_sent_; }
     size_t getStudentsSent() const { return students_sent_; }
+    size_t getSnapshotsSent() const { return snapshots_sent_; }
+    size_t getSnapshotChunksSent() const { return snapshot_chunks_sent_; }
+    size_t getDeltasSent() const { return deltas_sent_; }
+    size_t getSnapshotRequests() const { return snapshot_requests_; }
+    // Пересозданий сокета сервиса снимков после ошибок ZeroMQ
+    size_t getSnapshotRestarts() const { return snapshot_restarts_; }
+    // Следующий ответ сервиса снимков оборвётся ошибкой ZeroMQ (EFSM): проверка
+    // пересоздания сокета
+    void failNextSnapshotReply() { fail_next_reply_ = true; }
+    // Сообщения, вытесненные политикой или не отправленные при остановке
+    size_t getMessagesDropped() const { return messages_dropped_; }
+    // Размер сжатых сообщений до и после сжатия
+    size_t getBytesBeforeCompression() const { return bytes_before_compression_; }
+    size_t getBytesAfterCompression() const { return bytes_after_compression_; }
 
 private:
+    // Сообщение в очереди: тема (пустая - без кадра темы) и тело
+    struct QueuedMessage {
+        std::string topic;
+        std::string body;
+    };
+    
+    // Цепочка версий одной темы
+    struct TopicStream {
+        StudentTable last;
+        // Изменения из publishDelta, ещё не внесённые в last, и размер списка с ними
+        std::vector<StudentDelta> pending;
+        size_t pendingRecords = 0;
+        size_t size = 0;
+        uint64_t version = 0;
+        // Сериализованный снимок для запросов; строится один раз на версию и
+        // передаётся ZeroMQ по ссылке без копирования
+        std::shared_ptr<const std::string> reply;
+        uint64_t replyVersion = 0;
+    };
+    
     void run();
-    bool sendMessage(const std::string& message);
+    void runSnapshotService();
+    std::unique_ptr<zmq::socket_t> openSnapshotSocket();
+    void restartSnapshotSocket();
+    void closeSockets();
+    void sendSnapshotReply(const std::string& filter);
+    void sendCodecReply();
+    void compressMessage(std::string& message);
+    std::shared_ptr<const std::string> buildSnapshotReply(TopicStream& stream);
+    bool sendMessage(QueuedMessage&& message);
+    void enqueue(QueuedMessage&& message, bool supersedes);
+    bool dropOldest();
+    bool takeForcedSnapshot(const std::string& topic);
+    void publishStream(const std::string& topic, const StudentTable& students);
+    // Отправка новой версии темы: снимок stream.last или изменение delta
+    void sendVersion(const std::string& topic, TopicStream& stream, StudentDelta& delta,
+                     bool sendSnapshot);
+    void applyPending(TopicStream& stream);
+    void publishChunks(const std::string& topic, const StudentTable& students, uint64_t version);
+    
+    // Буферы отправленных сообщений переиспользуются для сериализации следующих.
+    // Пул разделяемый: ZeroMQ возвращает в него буфер из своего потока ввода-вывода
+    // после отправки, возможно уже после остановки издателя
+    struct BufferPool {
+        std::mutex mutex;
+        std::vector<std::string> spare;
+        
+        std::string take();
+        void recycle(std::string&& buffer);
+    };
+    
+    // Буфер во владении ZeroMQ до конца отправки
+    struct OwnedBuffer {
+        std::string data;
+        std::shared_ptr<BufferPool> pool;
+    };
+    
+    // Вызывается ZeroMQ после отправки сообщения
+    static void releaseBuffer(void* data, void* hint);
     
 private:
     std::unique_ptr<zmq::context_t> context_;
     std::unique_ptr<zmq::socket_t> socket_;
     std::thread worker_thread_;
+    std::unique_ptr<zmq::socket_t> snapshot_socket_;
+    std::thread snapshot_thread_;
+    // Управляющая пара inproc: stop будит сервис снимков, ждущий в poll
+    std::unique_ptr<zmq::socket_t> control_receiver_;
+    std::unique_ptr<zmq::socket_t> control_sender_;
     std::atomic<bool> running_;
     std::atomic<bool> stop_requested_;
     
-    // Очередь сообщений
-    std::queue<std::string> message_queue_;
-    mutable std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
+    // Очередь сообщений: несколько производителей, один поток отправки
+    MpscRing<QueuedMessage> message_queue_;
+    std::shared_ptr<BufferPool> buffer_pool_;
+    
+    static constexpr size_t MAX_SPARE_BUFFERS = 4;
+    static constexpr double DEFAULT_DELTA_THRESHOLD = 0.25;
+    static constexpr int SEND_HWM = 1000;
+    static constexpr size_t DEFAULT_SNAPSHOT_CHUNK_SIZE = 16384;
+    
+    std::atomic<BackpressurePolicy> policy_;
+    
+    // Последние опубликованные версии по темам
+    std::map<std::string, TopicStream> streams_;
+    mutable std::mutex update_mutex_;
+    std::atomic<double> delta_threshold_;
+    std::atomic<size_t> snapshot_chunk_size_;
+    // Темы, у которых из очереди вытеснена версия: подписчики потеряли цепочку.
+    // Отдельный мьютекс: вытеснение идёт и под update_mutex_, и без него
+    std::mutex forced_mutex_;
+    std::set<std::string> forced_topics_;
+    // Кодек сжатия; читается и меняется под update_mutex_
+    std::shared_ptr<const PayloadCodec> codec_;
+    
+    static constexpr int SNAPSHOT_RETRY_MS = 100;
+    static constexpr char CODEC_REQUEST[] = "CODEC";
+    static constexpr char CONTROL_ENDPOINT[] = "inproc://publisher-control";
+    std::atomic<bool> fail_next_reply_;
     
     // Статистика
     std::atomic<size_t> messages_sent_;
     std::atomic<size_t> students_sent_;
+    std::atomic<size_t> snapshots_sent_;
+    std::atomic<size_t> snapshot_chunks_sent_;
+    std::atomic<size_t> deltas_sent_;
+    std::atomic<size_t> snapshot_requests_;
+    std::atomic<size_t> snapshot_restarts_;
+    std::atomic<size_t> messages_dropped_;
+    std::atomic<size_t> bytes_before_compression_;
+    std::atomic<size_t> bytes_after_compression_;
     
     std::string endpoint_;
+    std::string snapshot_endpoint_;
+    std::atomic<Serializer::Format> format_;
 };
 
 #endif // ZMQ_PUBLISHER_HPP
\ No newline at end of file
@@ -1,22 +1,47 @@
 /*
  * ZeroMQ подписчик для получения данных студентов
- * Обрабатывает входящие сообщения и преобразует их в объекты Student
+ * Обрабатывает входящие сообщения и преобразует их в объекты Student.
+ * Конвейер: поток приёма забирает сообщения из сокета, пул потоков их
+ * декодирует, поток выдачи вызывает callback в порядке получения
  */
 
 #include "zmq_subscriber.hpp"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+uint64_t microsBetween(std::chrono::steady_clock::time_point from,
+                       std::chrono::steady_clock::time_point to) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    return micros > 0 ? static_cast<uint64_t>(micros) : 0;
+}
+
+} // namespace
+
+void ZmqSubscriber::StageLatency::add(uint64_t micros) {
+    count++;
+    totalMicros += micros;
+    maxMicros = std::max(maxMicros, micros);
+}
 
 ZmqSubscriber::ZmqSubscriber() 
-    : running_(false), stop_requested_(false),
-      messages_received_(0), students_received_(0) {
+    : decode_threads_count_(DEFAULT_DECODE_THREADS), running_(false), stop_requested_(false),
+      messages_received_(0), students_received_(0),
+      deltas_received_(0), deltas_skipped_(0), snapshots_requested_(0),
+      snapshot_chunks_received_(0), snapshots_abandoned_(0), compressed_received_(0), wakeups_(0),
+      next_sequence_(0), next_delivery_(0),
+      snapshot_needed_(false), codec_needed_(false), codec_unsupported_(false) {
 }
 
 ZmqSubscriber::~ZmqSubscriber() {
     stop();
 }
 
-bool ZmqSubscriber::start(const std::string& endpoint, const std::string& filter) {
+bool ZmqSubscriber::start(const std::string& endpoint, const std::string& filter,
+                          const std::string& snapshot_endpoint) {
     if (running_) {
         std::cerr << "Subscriber already running" << std::endl;
         return false;
@@ -25,6 +50,7 @@ bool ZmqSubscriber::start(const std::string& endpoint, const std::string& filter
     try {
         endpoint_ = endpoint;
         filter_ = filter;
+        snapshot_endpoint_ = snapshot_endpoint;
         
         context_ = std::make_unique<zmq::context_t>(1);
         socket_ = std::make_unique<zmq::socket_t>(*context_, ZMQ_SUB);
@@ -37,12 +63,44 @@ bool ZmqSubscriber::start(const std::string& endpoint, const std::string& filter
         socket_->connect(endpoint);
         socket_->set(zmq::sockopt::subscribe, filter);
         
+        // Контекст у каждого подписчика свой, поэтому имя inproc не пересекается
+        control_receiver_ = std::make_unique<zmq::socket_t>(*context_, ZMQ_PAIR);
+        control_receiver_->bind(CONTROL_ENDPOINT);
+        control_sender_ = std::make_unique<zmq::socket_t>(*context_, ZMQ_PAIR);
+        control_sender_->set(zmq::sockopt::linger, 0);
+        control_sender_->connect(CONTROL_ENDPOINT);
+        
         std::cout << "ZMQ Subscriber connected to " << endpoint 
                   << " with filter: '" << filter << "'" << std::endl;
         
+        // Подписка оформлена до запроса снимка: изменения не теряются
+        snapshot_needed_ = !snapshot_endpoint.empty();
+        codec_needed_ = false;
+        codec_unsupported_ = false;
+        std::atomic_store(&codec_, std::shared_ptr<const PayloadCodec>());
+        next_snapshot_attempt_ = std::chrono::steady_clock::now();
+        chunk_deadline_ = std::chrono::steady_clock::time_point::max();
+        
+        {
+            std::lock_guard<std::mutex> lock(pipeline_mutex_);
+            pending_.clear();
+            decoded_.clear();
+            next_sequence_ = 0;
+            next_delivery_ = 0;
+            pipeline_stats_ = PipelineStats();
+        }
+        {
+            std::lock_guard<std::mutex> lock(topics_mutex_);
+            topics_.clear();
+        }
+        
         running_ = true;
         stop_requested_ = false;
         worker_thread_ = std::thread(&ZmqSubscriber::run, this);
+        for (size_t i = 0; i < decode_threads_count_; ++i) {
+            decode_threads_.emplace_back(&ZmqSubscriber::runDecoder, this);
+        }
+        delivery_thread_ = std::thread(&ZmqSubscriber::runDelivery, this);
         
         return true;
     } catch (const zmq::error_t& e) {
@@ -57,12 +115,37 @@ bool ZmqSubscriber::start(const std::string& endpoint, const std::string& filter
 void ZmqSubscriber::stop() {
     if (!running_) return;
     
-    stop_requested_ = true;
+    // Флаг под мьютексом конвейера: ждущие потоки не пропустят пробуждение
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        stop_requested_ = true;
+    }
+    pending_cv_.notify_all();
+    decoded_cv_.notify_all();
+    space_cv_.notify_all();
+    try {
+        control_sender_->send(zmq::message_t(), zmq::send_flags::dontwait);
+    } catch (const zmq::error_t& e) {
+        std::cerr << "Subscriber control error: " << e.what() << std::endl;
+    }
     
     if (worker_thread_.joinable()) {
         worker_thread_.join();
     }
+    for (std::thread& decoder : decode_threads_) {
+        decoder.join();
+    }
+    decode_threads_.clear();
+    if (delivery_thread_.joinable()) {
+        delivery_thread_.join();
+    }
     
+    if (control_sender_) {
+        control_sender_->close();
+    }
+    if (control_receiver_) {
+        control_receiver_->close();
+    }
     if (socket_) {
         socket_->close();
     }
@@ -76,24 +159,59 @@ void ZmqSubscriber::stop() {
 }
 
 void ZmqSubscriber::run() {
+    zmq::pollitem_t items[] = {
+        {socket_->handle(), 0, ZMQ_POLLIN, 0},
+        {control_receiver_->handle(), 0, ZMQ_POLLIN, 0}
+    };
+    
     while (!stop_requested_) {
-        std::string message;
+        // Поток спит до сообщения или сигнала остановки
+        try {
+            zmq::poll(items, 2);
+        } catch (const zmq::error_t& e) {
+            std::cerr << "Poll error: " << e.what() << std::endl;
+            if (error_callback_) {
+                error_callback_(e.what());
+            }
+            break;
+        }
+        wakeups_++;
         
-        if (receiveMessage(message)) {
-            processMessage(message);
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (items[1].revents & ZMQ_POLLIN) {
+            break;
+        }
+        if (!(items[0].revents & ZMQ_POLLIN)) {
+            continue;
+        }
+        
+        // Накопившиеся сообщения забираются без повторного poll
+        std::string topic;
+        std::string message;
+        while (!stop_requested_ && receiveMessage(topic, message)) {
+            if (!enqueueFrame(std::move(topic), std::move(message))) {
+                break;
+            }
         }
     }
 }
 
-bool ZmqSubscriber::receiveMessage(std::string& message) {
+bool ZmqSubscriber::receiveMessage(std::string& topic, std::string& message) {
     try {
         zmq::message_t zmq_message;
         zmq::recv_result_t result = socket_->recv(zmq_message, zmq::recv_flags::dontwait);
         
         if (result) {
+            // Сообщение темы из двух кадров: тема, затем тело. Составное сообщение
+            // приходит целиком, поэтому второй кадр уже получен
+            topic.clear();
+            if (zmq_message.more()) {
+                topic.assign(static_cast<char*>(zmq_message.data()), zmq_message.size());
+                socket_->recv(zmq_message);
+            }
             message = std::string(static_cast<char*>(zmq_message.data()), zmq_message.size());
+            while (zmq_message.more()) {
+                socket_->recv(zmq_message);
+            }
             messages_received_++;
             return true;
         }
@@ -107,26 +225,522 @@ bool ZmqSubscriber::receiveMessage(std::string& message) {
     return false;
 }
 
-void ZmqSubscriber::processMessage(const std::string& message) {
+bool ZmqSubscriber::enqueueFrame(std::string&& topic, std::string&& message) {
+    std::unique_lock<std::mutex> lock(pipeline_mutex_);
+    
+    // Конвейер заполнен: следующие сообщения подождут в сокете
+    space_cv_.wait(lock, [this] {
+        return next_sequence_ - next_delivery_ < PIPELINE_CAPACITY || stop_requested_;
+    });
+    if (stop_requested_) {
+        return false;
+    }
+    
+    Frame frame;
+    frame.sequence = next_sequence_++;
+    frame.topic = std::move(topic);
+    frame.data = std::move(message);
+    frame.received = std::chrono::steady_clock::now();
+    pending_.push_back(std::move(frame));
+    pending_cv_.notify_one();
+    return true;
+}
+
+void ZmqSubscriber::runDecoder() {
+    while (true) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(pipeline_mutex_);
+            pending_cv_.wait(lock, [this] { return !pending_.empty() || stop_requested_; });
+            // Недоставленные при остановке сообщения отбрасываются
+            if (stop_requested_) {
+                return;
+            }
+            frame = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        
+        auto started = std::chrono::steady_clock::now();
+        decodeFrame(frame, std::atomic_load(&codec_).get());
+        frame.decoded = std::chrono::steady_clock::now();
+        
+        {
+            std::lock_guard<std::mutex> lock(pipeline_mutex_);
+            pipeline_stats_.queued.add(microsBetween(frame.received, started));
+            pipeline_stats_.decode.add(microsBetween(started, frame.decoded));
+            uint64_t sequence = frame.sequence;
+            decoded_.emplace(sequence, std::move(frame));
+        }
+        decoded_cv_.notify_one();
+    }
+}
+
+void ZmqSubscriber::decodeFrame(Frame& frame, const PayloadCodec* codec) {
+    try {
+        // Сжатое тело распаковывается, дальше разбор как обычно
+        if (PayloadCodec::isCompressed(frame.data)) {
+            frame.compressed = true;
+            if (!codec || codec->dictionaryId() != PayloadCodec::messageDictionaryId(frame.data)) {
+                frame.needsCodec = true;
+                frame.error = "Сжатое сообщение: словарь " +
+                              std::to_string(PayloadCodec::messageDictionaryId(frame.data)) +
+                              " не загружен";
+                return;
+            }
+            std::string plain;
+            codec->decompress(frame.data, plain);
+            frame.data = std::move(plain);
+        }
+        
+        BinarySerializer::Header header;
+        bool binary = BinarySerializer::readHeader(frame.data, header);
+        if (binary && header.kind == BinarySerializer::MessageKind::Delta) {
+            frame.isDelta = true;
+            frame.delta = BinarySerializer::deserializeDelta(frame.data);
+            return;
+        }
+        // Части снимка декодируются параллельно, собираются при выдаче
+        if (binary && header.kind == BinarySerializer::MessageKind::SnapshotChunk) {
+            frame.isChunk = true;
+            frame.chunk = BinarySerializer::deserializeSnapshotChunk(frame.data);
+            return;
+        }
+        
+        // Формат (JSON или двоичный) определяется по заголовку сообщения
+        frame.version = binary ? BinarySerializer::readVersion(frame.data) : 0;
+        frame.students = Serializer::decodeStudents(frame.data);
+    } catch (const std::exception& e) {
+        frame.error = e.what();
+    }
+}
+
+void ZmqSubscriber::runDelivery() {
+    while (true) {
+        if (std::chrono::steady_clock::now() >= chunk_deadline_) {
+            expireChunks();
+        }
+        if (snapshot_needed_ && std::chrono::steady_clock::now() >= next_snapshot_attempt_) {
+            // Сжатые сообщения без словаря потеряны: сначала кодек, затем снимок
+            bool codec_ready = !codec_needed_ || requestCodec();
+            if (!codec_ready || !requestSnapshot()) {
+                next_snapshot_attempt_ = std::chrono::steady_clock::now() +
+                                         std::chrono::milliseconds(SNAPSHOT_TIMEOUT_MS);
+            }
+        }
+        
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(pipeline_mutex_);
+            
+            // Выдаётся только следующий по номеру кадр, даже если более поздние
+            // декодированы раньше; повтор запроса снимка и срок ожидания части
+            // снимка прерывают ожидание
+            auto ready = [this] {
+                return stop_requested_ ||
+                       (!decoded_.empty() && decoded_.begin()->first == next_delivery_);
+            };
+            auto deadline = chunk_deadline_;
+            if (snapshot_needed_) {
+                deadline = std::min(deadline, next_snapshot_attempt_);
+            }
+            if (deadline != std::chrono::steady_clock::time_point::max()) {
+                if (!decoded_cv_.wait_until(lock, deadline, ready)) {
+                    continue;
+                }
+            } else {
+                decoded_cv_.wait(lock, ready);
+            }
+            if (stop_requested_) {
+                return;
+            }
+            
+            auto it = decoded_.begin();
+            frame = std::move(it->second);
+            decoded_.erase(it);
+            next_delivery_++;
+        }
+        space_cv_.notify_one();
+        
+        auto started = std::chrono::steady_clock::now();
+        deliverFrame(frame);
+        auto finished = std::chrono::steady_clock::now();
+        
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        pipeline_stats_.reorder.add(microsBetween(frame.decoded, started));
+        pipeline_stats_.deliver.add(microsBetween(started, finished));
+    }
+}
+
+ZmqSubscriber::PipelineStats ZmqSubscriber::getPipelineStats() const {
+    std::lock_guard<std::mutex> lock(pipeline_mutex_);
+    return pipeline_stats_;
+}
+
+void ZmqSubscriber::deliverFrame(Frame& frame) {
     // Вызываем raw callback если установлен
     if (raw_message_callback_) {
-        raw_message_callback_(message);
+        raw_message_callback_(frame.data);
+    }
+    
+    if (frame.compressed) {
+        compressed_received_++;
+    }
+    
+    // Кодек издателя ещё не получен или сменился словарь
+    if (frame.needsCodec && !snapshot_endpoint_.empty() && !codec_unsupported_) {
+        codec_needed_ = true;
+        snapshot_needed_ = true;
+        return;
+    }
+    
+    if (!frame.error.empty()) {
+        std::cerr << "Message processing error: " << frame.error << std::endl;
+        if (error_callback_) {
+            error_callback_(frame.error);
+        }
+        return;
     }
     
-    // Парсим и вызываем основной callback
     try {
-        std::vector<Student> students = Serializer::deserializeStudents(message);
-        students_received_ += students.size();
+        TopicState& state = topicState(frame.topic);
+        if (frame.isDelta) {
+            applyDelta(state, frame.delta);
+        } else if (frame.isChunk) {
+            applyChunk(state, std::move(frame.chunk));
+        } else {
+            applySnapshot(state, std::move(frame.students), frame.version);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Message processing error: " << e.what() << std::endl;
+        if (error_callback_) {
+            error_callback_(e.what());
+        }
+    }
+}
+
+ZmqSubscriber::TopicState& ZmqSubscriber::topicState(const std::string& topic) {
+    // Карту меняет только поток выдачи: поиск без блокировки, вставка под мьютексом
+    auto it = topics_.find(topic);
+    if (it != topics_.end()) {
+        return it->second;
+    }
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    return topics_[topic];
+}
+
+uint64_t ZmqSubscriber::getVersion(const std::string& topic) const {
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    auto it = topics_.find(topic);
+    return it != topics_.end() ? it->second.version.load() : 0;
+}
+
+size_t ZmqSubscriber::getTopicCount() const {
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    return topics_.size();
+}
+
+std::vector<Student> ZmqSubscriber::getStudents() const {
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    return mergedStudents();
+}
+
+size_t ZmqSubscriber::getStudentCount() const {
+    std::lock_guard<std::mutex> lock(topics_mutex_);
+    size_t total = 0;
+    for (const auto& topic : topics_) {
+        total += topic.second.students.size();
+    }
+    return total;
+}
+
+void ZmqSubscriber::notifyStudents(const TopicState& changed) {
+    if (!message_callback_) {
+        return;
+    }
+    if (topics_.size() == 1) {
+        message_callback_(changed.students);
+        return;
+    }
+    message_callback_(mergedStudents());
+}
+
+std::vector<Student> ZmqSubscriber::mergedStudents() const {
+    // Каждая тема отсортирована: общий список - слияние. Запись, перешедшая
+    // из темы в тему, уже удалена изменением прежней темы
+    std::vector<Student> merged;
+    size_t total = 0;
+    for (const auto& topic : topics_) {
+        total += topic.second.students.size();
+    }
+    merged.reserve(total);
+    for (const auto& topic : topics_) {
+        size_t middle = merged.size();
+        merged.insert(merged.end(), topic.second.students.begin(), topic.second.students.end());
+        std::inplace_merge(merged.begin(), merged.begin() + middle, merged.end());
+    }
+    return merged;
+}
+
+void ZmqSubscriber::applySnapshot(TopicState& state, std::vector<Student>&& students,
+                                  uint64_t version) {
+    // Снимок не новее текущей версии уже учтён (например, получен по запросу)
+    if (version != 0 && version <= state.version) {
+        return;
+    }
+    // Снимок не старше собираемого из частей заменяет его
+    if (state.assemblingActive && version >= state.assemblingVersion) {
+        state.assemblingActive = false;
+        std::vector<Student>().swap(state.assembling);
+    }
+    
+    size_t count = students.size();
+    students_received_ += count;
+    // У JSON-снимка нет версии: изменения не применяются до следующего двоичного снимка
+    state.version = version;
+    // Список темы хранится всегда: общий список собирается из всех тем
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        state.students = std::move(students);
+    }
+    notifyStudents(state);
+    
+    std::cout << "Received " << count << " students" << std::endl;
+}
+
+void ZmqSubscriber::applyDelta(TopicState& state, const StudentDelta& delta) {
+    // Части снимка идут подряд до следующего изменения темы: изменение посреди
+    // сборки значит, что конец снимка потерян
+    if (state.assemblingActive) {
+        abandonChunks(state, "Снимок " + std::to_string(state.assemblingVersion) +
+                             " не завершён: получено " + std::to_string(state.nextChunk) +
+                             " частей до изменения " + std::to_string(delta.version));
+        return;
+    }
+    
+    uint64_t version = state.version;
+    // Изменение уже вошло в полученный снимок
+    if (version != 0 && delta.version <= version) {
+        return;
+    }
+    
+    // Изменение применимо только к той версии, от которой оно построено
+    if (version == 0 || delta.baseVersion != version) {
+        deltas_skipped_++;
+        if (!snapshot_endpoint_.empty()) {
+            // Цепочка прервалась: состояние восстанавливается по снимку
+            std::cerr << "Пропущено изменение " << delta.baseVersion << " -> " << delta.version
+                      << ", запрос снимка" << std::endl;
+            snapshot_needed_ = true;
+            return;
+        }
+        std::string error = "Пропущено изменение " + std::to_string(delta.baseVersion) + " -> " +
+                            std::to_string(delta.version) + ": текущая версия " +
+                            std::to_string(version);
+        std::cerr << error << std::endl;
+        if (error_callback_) {
+            error_callback_(error);
+        }
+        return;
+    }
+    
+    state.version = delta.version;
+    deltas_received_++;
+    students_received_ += delta.size();
+    
+    // Изменение касается только записей своей темы
+    {
+        std::lock_guard<std::mutex> lock(topics_mutex_);
+        delta.apply(state.students);
+    }
+    if (delta_callback_) {
+        delta_callback_(delta);
+    } else {
+        notifyStudents(state);
+    }
+    
+    std::cout << "Received delta v" << delta.version << ": +" << delta.added.size()
+              << " -" << delta.removed.size() << " ~" << delta.modified.size() << std::endl;
+}
+
+void ZmqSubscriber::applyChunk(TopicState& state, BinarySerializer::SnapshotChunk&& chunk) {
+    snapshot_chunks_received_++;
+    
+    // Снимок уже учтён или это продолжение снимка, начало которого не получено
+    // (подписчик подключился посередине): ждём следующий снимок
+    if (state.version != 0 && chunk.version <= state.version) {
+        return;
+    }
+    if (chunk.index == 0) {
+        state.assembling.clear();
+        state.assembling.reserve(std::min(chunk.totalRecords, chunk.students.size() * chunk.count));
+        state.assemblingVersion = chunk.version;
+        state.nextChunk = 0;
+        state.assemblingActive = true;
+    } else if (!state.assemblingActive) {
+        return;
+    }
+    
+    // Часть потеряна: собранное не годится, состояние восстанавливается по снимку
+    if (chunk.version != state.assemblingVersion || chunk.index != state.nextChunk) {
+        abandonChunks(state, "Пропущена часть снимка " + std::to_string(state.assemblingVersion) +
+                             ": ожидалась " + std::to_string(state.nextChunk) +
+                             ", получена " + std::to_string(chunk.index));
+        return;
+    }
+    
+    state.assembling.insert(state.assembling.end(),
+                            std::make_move_iterator(chunk.students.begin()),
+                            std::make_move_iterator(chunk.students.end()));
+    state.nextChunk++;
+    if (state.nextChunk < chunk.count) {
+        // Потеряна последняя часть, а тема затихла: сборку прервёт срок ожидания
+        state.assemblingDeadline = std::chrono::steady_clock::now() +
+                                   std::chrono::milliseconds(CHUNK_TIMEOUT_MS);
+        chunk_deadline_ = std::min(chunk_deadline_, state.assemblingDeadline);
+        return;
+    }
+    
+    state.assemblingActive = false;
+    applySnapshot(state, std::move(state.assembling), state.assemblingVersion);
+    state.assembling.clear();
+}
+
+void ZmqSubscriber::abandonChunks(TopicState& state, const std::string& error) {
+    // Неполный снимок не выдаётся; память собранных частей освобождается сразу
+    state.assemblingActive = false;
+    std::vector<Student>().swap(state.assembling);
+    snapshots_abandoned_++;
+    std::cerr << error << std::endl;
+    if (!snapshot_endpoint_.empty()) {
+        snapshot_needed_ = true;
+    } else if (error_callback_) {
+        error_callback_(error);
+    }
+}
+
+void ZmqSubscriber::expireChunks() {
+    auto now = std::chrono::steady_clock::now();
+    chunk_deadline_ = std::chrono::steady_clock::time_point::max();
+    for (auto& topic : topics_) {
+        TopicState& state = topic.second;
+        if (!state.assemblingActive) {
+            continue;
+        }
+        if (state.assemblingDeadline <= now) {
+            abandonChunks(state, "Снимок " + std::to_string(state.assemblingVersion) +
+                                 " не завершён: нет части " + std::to_string(state.nextChunk) +
+                                 " за " + std::to_string(CHUNK_TIMEOUT_MS) + " мс");
+        } else {
+            chunk_deadline_ = std::min(chunk_deadline_, state.assemblingDeadline);
+        }
+    }
+}
+
+bool ZmqSubscriber::requestSnapshot() {
+    snapshots_requested_++;
+    try {
+        zmq::socket_t request = connectSnapshotService();
+        // Второй кадр - префикс тем: снимок только тех шардов, на которые оформлена подписка
+        request.send(zmq::buffer(SNAPSHOT_REQUEST, sizeof(SNAPSHOT_REQUEST) - 1),
+                     zmq::send_flags::sndmore);
+        request.send(zmq::buffer(filter_));
         
-        if (message_callback_) {
-            message_callback_(students);
+        zmq::message_t reply;
+        if (!request.recv(reply)) {
+            std::string error = "Snapshot service " + snapshot_endpoint_ + " is not responding";
+            std::cerr << error << std::endl;
+            if (error_callback_) {
+                error_callback_(error);
+            }
+            return false;
         }
         
-        std::cout << "Received " << students.size() << " students" << std::endl;
+        // Ответ - пары кадров (тема, снимок); один пустой кадр - данных ещё нет,
+        // первая версия придёт снимком через PUB
+        snapshot_needed_ = false;
+        while (reply.more()) {
+            Frame frame;
+            frame.topic.assign(static_cast<char*>(reply.data()), reply.size());
+            request.recv(reply);
+            frame.data.assign(static_cast<char*>(reply.data()), reply.size());
+            
+            // Снимок разбирается прямо в потоке выдачи: до него изменения не применить
+            decodeFrame(frame, std::atomic_load(&codec_).get());
+            if (frame.needsCodec && !codec_unsupported_ && requestCodec()) {
+                frame.needsCodec = false;
+                frame.error.clear();
+                decodeFrame(frame, std::atomic_load(&codec_).get());
+            }
+            deliverFrame(frame);
+            if (reply.more()) {
+                request.recv(reply);
+            }
+        }
+        return true;
     } catch (const std::exception& e) {
-        std::cerr << "Message processing error: " << e.what() << std::endl;
+        std::cerr << "Snapshot request error: " << e.what() << std::endl;
+        if (error_callback_) {
+            error_callback_(e.what());
+        }
+        return false;
+    }
+}
+
+bool ZmqSubscriber::requestCodec() {
+    try {
+        zmq::socket_t request = connectSnapshotService();
+        request.send(zmq::buffer(CODEC_REQUEST, sizeof(CODEC_REQUEST) - 1));
+        
+        zmq::message_t reply;
+        if (!request.recv(reply)) {
+            std::string error = "Snapshot service " + snapshot_endpoint_ + " is not responding";
+            std::cerr << error << std::endl;
+            if (error_callback_) {
+                error_callback_(error);
+            }
+            return false;
+        }
+        
+        // Ответ: имя кодека и словарь
+        std::string name = reply.to_string();
+        std::string dictionary;
+        if (reply.more()) {
+            request.recv(reply);
+            dictionary.assign(static_cast<char*>(reply.data()), reply.size());
+        }
+        codec_needed_ = false;
+        
+        if (name != "zstd") {
+            std::atomic_store(&codec_, std::shared_ptr<const PayloadCodec>());
+            return true;
+        }
+        if (!PayloadCodec::available()) {
+            codec_unsupported_ = true;
+            std::string error = "Издатель " + endpoint_ + " сжимает сообщения, клиент собран без zstd";
+            std::cerr << error << std::endl;
+            if (error_callback_) {
+                error_callback_(error);
+            }
+            return true;
+        }
+        
+        auto codec = std::make_shared<const PayloadCodec>(std::move(dictionary));
+        std::cout << "Сжатие zstd, словарь " << codec->dictionaryId() << std::endl;
+        std::atomic_store(&codec_, std::shared_ptr<const PayloadCodec>(std::move(codec)));
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Codec request error: " << e.what() << std::endl;
         if (error_callback_) {
             error_callback_(e.what());
         }
+        return false;
     }
-}
\ No newline at end of file
+}
+
+zmq::socket_t ZmqSubscriber::connectSnapshotService() {
+    zmq::socket_t request(*context_, ZMQ_REQ);
+    request.set(zmq::sockopt::linger, 0);
+    request.set(zmq::sockopt::rcvtimeo, SNAPSHOT_TIMEOUT_MS);
+    request.connect(snapshot_endpoint_);
+    return request;
+}
@@ -6,26 +6,70 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <zmq.hpp>
 #include "student.hpp"
 #include "serializer.hpp"
+#include "student_delta.hpp"
+#include "payload_codec.hpp"
 
 class ZmqSubscriber {
 public:
     using MessageCallback = std::function<void(const std::vector<Student>&)>;
+    using DeltaCallback = std::function<void(const StudentDelta&)>;
     using RawMessageCallback = std::function<void(const std::string&)>;
     using ErrorCallback = std::function<void(const std::string&)>;
     
+    // Задержка одного этапа конвейера в микросекундах
+    struct StageLatency {
+        uint64_t count = 0;
+        uint64_t totalMicros = 0;
+        uint64_t maxMicros = 0;
+        
+        double averageMicros() const { return count ? static_cast<double>(totalMicros) / count : 0.0; }
+        void add(uint64_t micros);
+    };
+    
+    // Этапы: ожидание декодера после приёма, декодирование, ожидание своей
+    // очереди на выдачу (порядок сообщений) и выполнение callback
+    struct PipelineStats {
+        StageLatency queued;
+        StageLatency decode;
+        StageLatency reorder;
+        StageLatency deliver;
+    };
+    
+    static constexpr size_t DEFAULT_DECODE_THREADS = 2;
+    
     ZmqSubscriber();
     ~ZmqSubscriber();
     
-    // Подключение и отключение
+    // Подключение и отключение. Если задан snapshot_endpoint, после подписки
+    // у издателя запрашивается текущий снимок с версией; дальше применяются только
+    // более новые сообщения потока, а при разрыве цепочки снимок запрашивается снова.
+    // filter - префикс темы: при публикации по темам подписчик получает только свои
+    // шарды, снимок по запросу тоже содержит только их. Получив сжатое сообщение,
+    // подписчик узнаёт кодек и словарь у сервиса снимков
     bool start(const std::string& endpoint = "tcp://localhost:5556", 
-               const std::string& filter = "");
+               const std::string& filter = "",
+               const std::string& snapshot_endpoint = "");
     void stop();
     
-    // Callback функции
+    // Число потоков декодирования; задаётся до start. Поток приёма только забирает
+    // сообщения из сокета, поэтому долгий разбор большого снимка не заполняет rcvhwm
+    void setDecodeThreads(size_t threads) { decode_threads_count_ = threads > 0 ? threads : 1; }
+    size_t getDecodeThreads() const { return decode_threads_count_; }
+    
+    // Callback функции вызываются из одного потока выдачи в порядке получения сообщений
     void setMessageCallback(MessageCallback callback) { message_callback_ = callback; }
+    // Если задан, изменения передаются ему, а полный список - только со снимками.
+    // Без него подписчик сам применяет изменения и вызывает message_callback
+    // с обновлённым списком
+    void setDeltaCallback(DeltaCallback callback) { delta_callback_ = callback; }
     void setRawMessageCallback(RawMessageCallback callback) { raw_message_callback_ = callback; }
     void setErrorCallback(ErrorCallback callback) { error_callback_ = callback; }
     
@@ -35,30 +79,155 @@ public:
     // Статистика
     size_t getMessagesReceived() const { return messages_received_; }
     size_t getStudentsReceived() const { return students_received_; }
+    size_t getDeltasReceived() const { return deltas_received_; }
+    size_t getDeltasSkipped() const { return deltas_skipped_; }
+    size_t getSnapshotsRequested() const { return snapshots_requested_; }
+    size_t getSnapshotChunksReceived() const { return snapshot_chunks_received_; }
+    // Снимков, собранных из частей не полностью и отброшенных
+    size_t getSnapshotsAbandoned() const { return snapshots_abandoned_; }
+    size_t getCompressedReceived() const { return compressed_received_; }
+    // Кодек, полученный от издателя; nullptr - издатель не сжимает сообщения
+    std::shared_ptr<const PayloadCodec> getCodec() const { return std::atomic_load(&codec_); }
+    // Пробуждения потока приёма; простаивающий подписчик не просыпается
+    size_t getWakeups() const { return wakeups_; }
+    PipelineStats getPipelineStats() const;
+    // Версия темы; без темы - версия списка, опубликованного без разбиения
+    uint64_t getVersion(const std::string& topic = "") const;
+    // Число полученных тем
+    size_t getTopicCount() const;
+    
+    // Текущий список: слияние списков всех тем. Подписчик хранит списки тем сам
+    // и применяет к каждому изменения только этой темы, поэтому клиенту не нужна
+    // своя копия; возвращается копия для показа
+    std::vector<Student> getStudents() const;
+    size_t getStudentCount() const;
 
 private:
+    // Сообщение на конвейере: принятый кадр, затем результат декодирования
+    struct Frame {
+        uint64_t sequence = 0;
+        std::string topic;
+        std::string data;
+        std::chrono::steady_clock::time_point received;
+        std::chrono::steady_clock::time_point decoded;
+        
+        bool compressed = false;
+        bool needsCodec = false;  // сжато словарём, которого у подписчика нет
+        bool isDelta = false;
+        bool isChunk = false;
+        uint64_t version = 0;
+        std::vector<Student> students;
+        StudentDelta delta;
+        BinarySerializer::SnapshotChunk chunk;
+        std::string error;
+    };
+    
+    // Состояние одной темы; меняется только потоком выдачи
+    struct TopicState {
+        // Текущая версия; 0 - версия неизвестна, изменения не применяются
+        std::atomic<uint64_t> version{0};
+        std::vector<Student> students;
+        
+        // Снимок, собираемый из частей по мере их прихода; номер следующей ожидаемой части.
+        // Без следующей части до assemblingDeadline собранное отбрасывается
+        std::vector<Student> assembling;
+        uint64_t assemblingVersion = 0;
+        size_t nextChunk = 0;
+        bool assemblingActive = false;
+        std::chrono::steady_clock::time_point assemblingDeadline;
+    };
+    
     void run();
-    bool receiveMessage(std::string& message);
-    void processMessage(const std::string& message);
+    void runDecoder();
+    void runDelivery();
+    bool receiveMessage(std::string& topic, std::string& message);
+    bool enqueueFrame(std::string&& topic, std::string&& message);
+    static void decodeFrame(Frame& frame, const PayloadCodec* codec);
+    void deliverFrame(Frame& frame);
+    TopicState& topicState(const std::string& topic);
+    void notifyStudents(const TopicState& changed);
+    std::vector<Student> mergedStudents() const;
+    void applySnapshot(TopicState& state, std::vector<Student>&& students, uint64_t version);
+    void applyDelta(TopicState& state, const StudentDelta& delta);
+    void applyChunk(TopicState& state, BinarySerializer::SnapshotChunk&& chunk);
+    void abandonChunks(TopicState& state, const std::string& error);
+    void expireChunks();
+    bool requestSnapshot();
+    bool requestCodec();
+    zmq::socket_t connectSnapshotService();
     
 private:
     std::unique_ptr<zmq::context_t> context_;
     std::unique_ptr<zmq::socket_t> socket_;
+    // Управляющая пара inproc: stop будит поток приёма, ждущий в poll
+    std::unique_ptr<zmq::socket_t> control_receiver_;
+    std::unique_ptr<zmq::socket_t> control_sender_;
     std::thread worker_thread_;
+    std::vector<std::thread> decode_threads_;
+    std::thread delivery_thread_;
+    size_t decode_threads_count_;
     std::atomic<bool> running_;
     std::atomic<bool> stop_requested_;
     
     // Callback функции
     MessageCallback message_callback_;
+    DeltaCallback delta_callback_;
     RawMessageCallback raw_message_callback_;
     ErrorCallback error_callback_;
     
     // Статистика
     std::atomic<size_t> messages_received_;
     std::atomic<size_t> students_received_;
+    std::atomic<size_t> deltas_received_;
+    std::atomic<size_t> deltas_skipped_;
+    std::atomic<size_t> snapshots_requested_;
+    std::atomic<size_t> snapshot_chunks_received_;
+    std::atomic<size_t> snapshots_abandoned_;
+    std::atomic<size_t> compressed_received_;
+    std::atomic<size_t> wakeups_;
+    
+    // Конвейер: кадры ждут декодера в pending_, готовые - выдачи в decoded_ по номеру.
+    // Число кадров на конвейере ограничено, дальше сообщения ждут в сокете
+    mutable std::mutex pipeline_mutex_;
+    std::condition_variable pending_cv_;
+    std::condition_variable decoded_cv_;
+    std::condition_variable space_cv_;
+    std::deque<Frame> pending_;
+    std::map<uint64_t, Frame> decoded_;
+    uint64_t next_sequence_;
+    uint64_t next_delivery_;
+    PipelineStats pipeline_stats_;
+    
+    static constexpr size_t PIPELINE_CAPACITY = 64;
+    
+    // Темы по имени; без разбиения на издателе - одна тема с пустым именем.
+    // Меняет карту и списки тем только поток выдачи, под мьютексом; сам он читает
+    // их без блокировки, остальные потоки - под мьютексом
+    std::map<std::string, TopicState> topics_;
+    mutable std::mutex topics_mutex_;
+    
+    // Запрос снимка выполняет поток выдачи; до ответа сообщения потока ждут на конвейере
+    bool snapshot_needed_;
+    std::chrono::steady_clock::time_point next_snapshot_attempt_;
+    // Ближайший срок ожидания части снимка; max - снимки частями не собираются
+    std::chrono::steady_clock::time_point chunk_deadline_;
+    
+    // Кодек читают потоки декодирования, заменяет поток выдачи (atomic_load/atomic_store).
+    // codec_needed_ - перед снимком запросить кодек; codec_unsupported_ - издатель
+    // сжимает, а подписчик собран без zstd
+    std::shared_ptr<const PayloadCodec> codec_;
+    bool codec_needed_;
+    bool codec_unsupported_;
+    
+    static constexpr char SNAPSHOT_REQUEST[] = "SNAPSHOT";
+    static constexpr char CODEC_REQUEST[] = "CODEC";
+    static constexpr int SNAPSHOT_TIMEOUT_MS = 1000;
+    static constexpr int CHUNK_TIMEOUT_MS = 1000;
+    static constexpr char CONTROL_ENDPOINT[] = "inproc://subscriber-control";
     
     std::string endpoint_;
     std::string filter_;
+    std::string snapshot_endpoint_;
 };
 
 #endif // ZMQ_SUBSCRIBER_HPP
\ No newline at end of file
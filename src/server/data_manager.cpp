@@ -5,66 +5,277 @@
 
 #include "data_manager.hpp"
 #include <iostream>
+#include <algorithm>
 #include <unordered_set>
 #include <functional>
+#include <string_view>
+#include <unordered_map>
 
-DataManager::MergeResult DataManager::mergeStudents(const std::vector<Student>& list1, const std::vector<Student>& list2) {
-    MergeResult result;
+namespace {
+
+// Значения одного ФИО по дате рождения: в больших списках тёзок с разными датами
+// может быть много, поэтому поиск по хэш-таблице, а не перебором
+template <typename Value>
+class BirthDateIndex {
+public:
+    bool empty() const { return map_.empty(); }
     
-    std::vector<Student> allStudents;
-    allStudents.reserve(list1.size() + list2.size());
-    allStudents.insert(allStudents.end(), list1.begin(), list1.end());
-    allStudents.insert(allStudents.end(), list2.begin(), list2.end());
+    Value* find(Date date) {
+        auto it = map_.find(date.daysSinceEpoch());
+        return it == map_.end() ? nullptr : &it->second;
+    }
     
-    result.totalStudents = allStudents.size();
+    Value& insert(Date date, const Value& value) {
+        return map_.emplace(date.daysSinceEpoch(), value).first->second;
+    }
     
-    result.mergedStudents = removeDuplicates(allStudents);
-    result.duplicatesRemoved = result.totalStudents - result.mergedStudents.size();
-    result.duplicates = findDuplicates(allStudents);
+    // Сброс при смене ФИО. После длинного ряда таблица пересоздаётся: clear
+    // проходит по всем корзинам, а короткие ряды идут подряд миллионами
+    void clear() {
+        if (map_.bucket_count() > SMALL_BUCKETS) {
+            map_ = std::unordered_map<int32_t, Value>();
+        } else {
+            map_.clear();
+        }
+    }
     
-    result.mergedStudents = sortStudentsByName(result.mergedStudents);
+private:
+    static constexpr size_t SMALL_BUCKETS = 64;
+    std::unordered_map<int32_t, Value> map_;
+};
+
+} // namespace
+
+DataManager::MergeResult DataManager::mergeStudents(const std::vector<Student>& list1,
+                                                   const std::vector<Student>& list2,
+                                                   DuplicateReport report) {
+    return mergeLists({&list1, &list2}, report);
+}
+
+DataManager::MergeResult DataManager::mergeMultipleLists(const std::vector<std::vector<Student>>& lists,
+                                                         DuplicateReport report) {
+    // Проверка порядка линейна и дешевле общей сортировки
+    if (lists.size() > 1 && std::all_of(lists.begin(), lists.end(), isSortedByName)) {
+        return mergeSortedLists(lists, report);
+    }
     
-    return result;
+    std::vector<const std::vector<Student>*> pointers;
+    pointers.reserve(lists.size());
+    for (const std::vector<Student>& list : lists) {
+        pointers.push_back(&list);
+    }
+    return mergeLists(pointers, report);
 }
 
-DataManager::MergeResult DataManager::mergeMultipleLists(const std::vector<std::vector<Student>>& lists) {
+DataManager::MergeResult DataManager::mergeLists(const std::vector<const std::vector<Student>*>& lists,
+                                                 DuplicateReport report) {
     MergeResult result;
     
-    if (lists.empty()) {
-        return result;
+    size_t total = 0;
+    for (const std::vector<Student>* list : lists) {
+        total += list->size();
     }
+    result.totalStudents = total;
+    
+    // Таблица хранит индексы уникальных записей; хэш по адресам интернированных имён
+    std::vector<Student>& unique = result.mergedStudents;
+    unique.reserve(total);
+    auto indexHash = [&unique](size_t index) {
+        const Student& s = unique[index];
+        size_t h = s.getLastNameHandle().hash();
+        h = h * 31 + s.getFirstNameHandle().hash();
+        return h * 31 + std::hash<int32_t>{}(s.getBirthDateValue().daysSinceEpoch());
+    };
+    auto indexEqual = [&unique](size_t a, size_t b) {
+        return unique[a] == unique[b];
+    };
+    std::unordered_set<size_t, decltype(indexHash), decltype(indexEqual)>
+        seen(total, indexHash, indexEqual);
+    
+    // Номер группы дубликатов для каждой уникальной записи
+    constexpr size_t NO_GROUP = static_cast<size_t>(-1);
+    std::vector<size_t> groupOf;
+    std::vector<DuplicateGroup>& groups = result.duplicateGroups;
     
-    std::vector<Student> allStudents;
-    for (const & list : lists) {
-        allStudents.insert(allStudents.end(), list.begin(), list.end());
+    for (const std::vector<Student>* list : lists) {
+        for (const Student& student : *list) {
+            // Кандидат дописывается в конец; при повторе он снимается
+            unique.push_back(student);
+            auto inserted = seen.insert(unique.size() - 1);
+            if (inserted.second) {
+                continue;
+            }
+            unique.pop_back();
+            if (report == DuplicateReport::None) {
+                continue;
+            }
+            
+            size_t first = *inserted.first;
+            if (groupOf.size() <= first) {
+                groupOf.resize(unique.size(), NO_GROUP);
+            }
+            if (groupOf[first] == NO_GROUP) {
+                groupOf[first] = groups.size();
+                groups.emplace_back();
+                groups.back().student = unique[first];
+                groups.back().count = 1;
+                if (report == DuplicateReport::Records) {
+                    groups.back().records.push_back(unique[first]);
+                }
+            }
+            DuplicateGroup& group = groups[groupOf[first]];
+            group.count++;
+            if (report == DuplicateReport::Records) {
+                group.records.push_back(student);
+            }
+        }
+    }
+    result.duplicatesRemoved = result.totalStudents - unique.size();
+    orderDuplicateGroups(result);
+    
+    std::sort(unique.begin(), unique.end());
+    return result;
+}
+
+DataManager::MergeResult DataManager::mergeSortedLists(const std::vector<std::vector<Student>>& lists,
+                                                       DuplicateReport report) {
+    MergeResult result;
+    for (const std::vector<Student>& list : lists) {
         result.totalStudents += list.size();
     }
+    result.mergedStudents.reserve(result.totalStudents);
     
-    result.mergedStudents = removeDuplicates(allStudents);
+    // Повтор приходит, пока текущее ФИО не сменилось: группы ищутся по дате
+    // рождения только среди групп этого ФИО
+    BirthDateIndex<size_t> runGroups;
+    kWayMerge(lists,
+        [&result, &runGroups](const Student& student) {
+            if (!result.mergedStudents.empty() && result.mergedStudents.back() < student) {
+                runGroups.clear();
+            }
+            result.mergedStudents.push_back(student);
+        },
+        [&result, &runGroups, report](const Student& first, const Student& repeat) {
+            if (report == DuplicateReport::None) {
+                return;
+            }
+            DuplicateGroup* group = nullptr;
+            if (size_t* index = runGroups.find(first.getBirthDateValue())) {
+                group = &result.duplicateGroups[*index];
+            } else {
+                runGroups.insert(first.getBirthDateValue(), result.duplicateGroups.size());
+                result.duplicateGroups.emplace_back();
+                group = &result.duplicateGroups.back();
+                group->student = first;
+                group->count = 1;
+                if (report == DuplicateReport::Records) {
+                    group->records.push_back(first);
+                }
+            }
+            group->count++;
+            if (report == DuplicateReport::Records) {
+                group->records.push_back(repeat);
+            }
+        });
+    
+    // Внутри одного ФИО группы созданы в порядке первого повтора, а не по дате
     result.duplicatesRemoved = result.totalStudents - result.mergedStudents.size();
-    result.duplicates = findDuplicates(allStudents);
+    orderDuplicateGroups(result);
+    return result;
+}
+
+void DataManager::orderDuplicateGroups(MergeResult& result) {
+    // Личности групп различны, порядок однозначен для любого способа слияния
+    std::sort(result.duplicateGroups.begin(), result.duplicateGroups.end(),
+              [](const DuplicateGroup& a, const DuplicateGroup& b) {
+                  if (a.student < b.student) return true;
+                  if (b.student < a.student) return false;
+                  return a.student.getBirthDateValue() < b.student.getBirthDateValue();
+              });
+    for (const DuplicateGroup& group : result.duplicateGroups) {
+        result.duplicates.insert(result.duplicates.end(), group.records.begin(), group.records.end());
+    }
+}
+
+size_t DataManager::kWayMerge(const std::vector<std::vector<Student>>& lists, const StudentSink& sink,
+                              const DuplicateSink& duplicate) {
+    // Позиция в списке; при равных ФИО первым идёт более ранний список
+    struct Cursor {
+        size_t list;
+        size_t position;
+    };
+    auto after = [&lists](const Cursor& a, const Cursor& b) {
+        const Student& sa = lists[a.list][a.position];
+        const Student& sb = lists[b.list][b.position];
+        if (sb < sa) return true;
+        if (sa < sb) return false;
+        return a.list > b.list;
+    };
     
-    result.mergedStudents = sortStudentsByName(result.mergedStudents);
+    std::vector<Cursor> heap;
+    heap.reserve(lists.size());
+    for (size_t list = 0; list < lists.size(); ++list) {
+        if (!lists[list].empty()) {
+            heap.push_back(Cursor{list, 0});
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), after);
     
-    return result;
+    // Выданные записи текущего ФИО по дате рождения: повтор может прийти не сразу,
+    // если у тёзок разные даты рождения
+    BirthDateIndex<Student> run;
+    Student runName;
+    size_t emitted = 0;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), after);
+        Cursor& cursor = heap.back();
+        const Student& student = lists[cursor.list][cursor.position];
+        
+        if (!run.empty() && runName < student) {
+            run.clear();
+        }
+        if (run.empty()) {
+            runName = student;
+        }
+        if (const Student* first = run.find(student.getBirthDateValue())) {
+            duplicate(*first, student);
+        } else {
+            run.insert(student.getBirthDateValue(), student);
+            sink(student);
+            emitted++;
+        }
+        
+        if (++cursor.position < lists[cursor.list].size()) {
+            std::push_heap(heap.begin(), heap.end(), after);
+        } else {
+            heap.pop_back();
+        }
+    }
+    return emitted;
+}
+
+bool DataManager::isSortedByName(const std::vector<Student>& students) {
+    return std::is_sorted(students.begin(), students.end());
 }
 
 std::vector<Student> DataManager::removeDuplicates(const std::vector<Student>& students) {
     std::vector<Student> uniqueStudents;
     
-     studentHash = [](const Student& s) {
-        return std::hash<std::string>{}(s.getLastName() + s.getFirstName() + 
-                                       s.getBirthDate());
+    // Хэш по адресам интернированных имён, без склейки строк
+    auto studentHash = [](const Student& s) {
+        size_t h = s.getLastNameHandle().hash();
+        h = h * 31 + s.getFirstNameHandle().hash();
+        return h * 31 + std::hash<int32_t>{}(s.getBirthDateValue().daysSinceEpoch());
     };
     
-     studentEqual = [](const Student& s1, const Student& s2) {
+    auto studentEqual = [](const Student& s1, const Student& s2) {
         return s1 == s2;
     };
     
     std::unordered_set<Student, decltype(studentHash), decltype(studentEqual)> 
         seenStudents(students.size(), studentHash, studentEqual);
     
-    for (const & student : students) {
+    for (const Student& student : students) {
         if (seenStudents.insert(student).second) {
             uniqueStudents.push_back(student);
         }
@@ -82,7 +293,7 @@ std::vector<Student> DataManager::sortStudentsByName(const std::vector<Student>&
 std::vector<Student> DataManager::filterValidStudents(const std::vector<Student>& students) {
     std::vector<Student> validStudents;
     
-    for (const & student : students) {
+    for (const Student& student : students) {
         if (student.isValid()) {
             validStudents.push_back(student);
         }
@@ -91,30 +302,68 @@ std::vector<Student> DataManager::filterValidStudents(const std::vector<Student>
     return validStudents;
 }
 
-bool DataManager::isDuplicate(const Student& s1, const Student& s2) const {
-    return s1 == s2;
+StudentTable DataManager::removeDuplicates(const StudentTable& students) {
+    // Хэш и сравнение работают прямо по колонкам, без создания объектов Student
+    auto rowHash = [&students](size_t row) {
+        size_t h = std::hash<std::string_view>{}(students.lastName(row));
+        h = h * 31 + std::hash<std::string_view>{}(students.firstName(row));
+        return h * 31 + std::hash<int32_t>{}(students.birthDate(row).daysSinceEpoch());
+    };
+    
+    auto rowEqual = [&students](size_t a, size_t b) {
+        return students.birthDate(a) == students.birthDate(b) &&
+               students.lastName(a) == students.lastName(b) &&
+               students.firstName(a) == students.firstName(b);
+    };
+    
+    std::unordered_set<size_t, decltype(rowHash), decltype(rowEqual)> 
+        seenRows(students.size(), rowHash, rowEqual);
+    
+    std::vector<size_t> uniqueRows;
+    uniqueRows.reserve(students.size());
+    for (size_t row = 0; row < students.size(); ++row) {
+        if (seenRows.insert(row).second) {
+            uniqueRows.push_back(row);
+        }
+    }
+    
+    return students.select(uniqueRows);
 }
 
-std::vector<Student> DataManager::findDuplicates(const std::vector<Student>& students) {
-    std::vector<Student> duplicates;
-    std::vector<bool> isDuplicate(students.size(), false);
+StudentTable DataManager::sortStudentsByName(const StudentTable& students) {
+    std::vector<size_t> order(students.size());
+    for (size_t row = 0; row < order.size(); ++row) {
+        order[row] = row;
+    }
     
-    for (size_t i = 0; i < students.size(); ++i) {
-        if (isDuplicate[i]) continue;
-        
-        for (size_t j = i + 1; j < students.size(); ++j) {
-            if (students[i] == students[j]) {
-                if (!isDuplicate[i]) {
-                    duplicates.push_back(students[i]);
-                    isDuplicate[i] = true;
-                }
-                duplicates.push_back(students[j]);
-                isDuplicate[j] = true;
-            }
+    std::sort(order.begin(), order.end(), [&students](size_t a, size_t b) {
+        std::string_view lastA = students.lastName(a);
+        std::string_view lastB = students.lastName(b);
+        if (lastA != lastB) {
+            return lastA < lastB;
         }
-    }
+        return students.firstName(a) < students.firstName(b);
+    });
     
-    return duplicates;
+    return students.select(order);
 }
 
+StudentTable DataManager::filterValidStudents(const StudentTable& students) {
+    std::vector<size_t> validRows;
+    validRows.reserve(students.size());
+    
+    for (size_t row = 0; row < students.size(); ++row) {
+        if (students.isValidRow(row)) {
+            validRows.push_back(row);
+        }
+    }
+    
+    if (validRows.size() == students.size()) {
+        return students;
+    }
+    return students.select(validRows);
+}
 
+bool DataManager::isDuplicate(const Student& s1, const Student& s2) const {
+    return s1 == s2;
+}
@@ -4,31 +4,78 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <functional>
 #include "../common/student.hpp"
+#include "../common/student_table.hpp"
+#include "student_store.hpp"
 
 class DataManager {
 public:
+    // Подробность отчёта о дубликатах
+    enum class DuplicateReport {
+        Records,  // группы со всеми записями и плоский список duplicates
+        Counts,   // только группы с числом записей
+        None
+    };
+    
+    // Записи с одной личностью (ФИО и дата рождения), встретившиеся больше одного раза
+    struct DuplicateGroup {
+        Student student;               // первая встреченная запись
+        size_t count;                  // сколько раз встретилась
+        std::vector<Student> records;  // все записи по порядку (только Records)
+        
+        DuplicateGroup() : count(0) {}
+    };
+    
     // Результат обработки данных
     struct MergeResult {
         std::vector<Student> mergedStudents;
         int totalStudents;
         int duplicatesRemoved;
+        // Записи всех групп подряд. Группы в обоих способах слияния идут
+        // в порядке личности: ФИО, затем дата рождения
         std::vector<Student> duplicates;
+        std::vector<DuplicateGroup> duplicateGroups;
         
         MergeResult() : totalStudents(0), duplicatesRemoved(0) {}
     };
 
-    // Объединение списков с удалением дубликатов
-    MergeResult mergeStudents(const std::vector<Student>& list1, const std::vector<Student>& list2);
+    // Объединение списков с удалением дубликатов. Уникальные записи и отчёт
+    // о дубликатах строятся за один проход по хэш-таблице
+    MergeResult mergeStudents(const std::vector<Student>& list1, const std::vector<Student>& list2,
+                              DuplicateReport report = DuplicateReport::Records);
+    
+    // Объединение нескольких списков. Если все списки уже отсортированы по ФИО,
+    // они сливаются k-путевым слиянием без общей сортировки (см. mergeSortedLists)
+    MergeResult mergeMultipleLists(const std::vector<std::vector<Student>>& lists,
+                                   DuplicateReport report = DuplicateReport::Records);
     
-    // Объединение нескольких списков
-    MergeResult mergeMultipleLists(const std::vector<std::vector<Student>>& lists);
+    // K-путевое слияние списков, отсортированных по ФИО: куча из головных записей
+    // списков, O(n log k). Повторы удаляются по ходу слияния: одинаковые записи
+    // соседствуют в пределах одного ФИО. Из повторов остаётся запись из более
+    // раннего списка, как при слиянии через хэш-таблицу; порядок групп дубликатов
+    // тот же
+    MergeResult mergeSortedLists(const std::vector<std::vector<Student>>& lists,
+                                 DuplicateReport report = DuplicateReport::Records);
+    
+    // Отсортирован ли список по ФИО (порядок сортировки sortStudentsByName)
+    static bool isSortedByName(const std::vector<Student>& students);
     
     // Дополнительные функции обработки
     std::vector<Student> removeDuplicates(const std::vector<Student>& students);
     std::vector<Student> sortStudentsByName(const std::vector<Student>& students);
     std::vector<Student> filterValidStudents(const std::vector<Student>& students);
     
+    // Те же операции над колоночной таблицей
+    StudentTable removeDuplicates(const StudentTable& students);
+    StudentTable sortStudentsByName(const StudentTable& students);
+    StudentTable filterValidStudents(const StudentTable& students);
+    
+    // Долгоживущий объединённый список по файлам-источникам: изменённый файл
+    // обновляет только свои записи, без пересборки и сортировки всего списка
+    StudentStore& store() { return store_; }
+    const StudentStore& store() const { return store_; }
+    
     // Статистика
     //void printMergeStatistics(const MergeResult& result) const;
 
@@ -36,7 +83,20 @@ public:
 private:
     // Вспомогательные функции
     bool isDuplicate(const Student& s1, const Student& s2) const;
-    std::vector<Student> findDuplicates(const std::vector<Student>& students);
+    MergeResult mergeLists(const std::vector<const std::vector<Student>*>& lists,
+                           DuplicateReport report);
+    
+    // Группы по личности и плоский список duplicates в том же порядке
+    static void orderDuplicateGroups(MergeResult& result);
+    
+    // Потребитель уникальных записей по порядку ФИО; повтор записи: первая
+    // выданная запись с той же личностью и сам повтор
+    using StudentSink = std::function<void(const Student&)>;
+    using DuplicateSink = std::function<void(const Student& first, const Student& repeat)>;
+    size_t kWayMerge(const std::vector<std::vector<Student>>& lists, const StudentSink& sink,
+                     const DuplicateSink& duplicate);
+    
+    StudentStore store_;
 };
 
 #endif // DATA_MANAGER_HPP
\ No newline at end of file
@@ -1,202 +1,520 @@
 #include "data_parser.hpp"
-#include <fstream>
-#include <sstream>
 #include <iostream>
 #include <algorithm>
-#include <cctype>
+#include <charconv>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <memory>
+#include <cstdint>
 
-// Вспомогательная функция для трима строки
-std::string trim(const std::string& str) {
-    size_t start = str.find_first_not_of(" \t\n\r");
-    if (start == std::string::npos) return "";
-    
-    size_t end = str.find_last_not_of(" \t\n\r");
-    return str.substr(start, end - start + 1);
+DataParser::DataParser(size_t workerCount)
+    : workerCount_(1), chunkSize_(DEFAULT_CHUNK_SIZE), batchSize_(DEFAULT_BATCH_SIZE),
+      maxErrorsPerFile_(ParseErrorLog::DEFAULT_MAX_STORED), fileMode_(MappedFile::Mode::Read) {
+    setWorkerCount(workerCount);
+}
+
+void DataParser::setWorkerCount(size_t workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workerCount_ = workerCount;
+}
+
+void DataParser::setChunkSize(size_t chunkSize) {
+    chunkSize_ = std::max<size_t>(chunkSize, 1);
+}
+
+void DataParser::setBatchSize(size_t batchSize) {
+    batchSize_ = std::max<size_t>(batchSize, 1);
 }
 
 DataParser::ParseResult DataParser::parseStudentFile(const std::string& filename) {
-    ParseResult result;
+    return std::move(parseFiles({filename}, {}).front());
+}
+
+DataParser::ParseResult DataParser::parseStudentFile(const std::string& filename, StudentTable& table) {
+    return std::move(parseFiles({filename}, {&table}).front());
+}
+
+std::vector<DataParser::FileChunk> DataParser::prepareChunks(const std::vector<std::string>& filenames,
+                                                             std::vector<MappedFile>& files,
+                                                             std::vector<ParseResult>& results) const {
+    std::vector<FileChunk> chunks;
     
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        result.errors.push_back("Ошибка: Не удалось открыть файл " + filename);
-        return result;
+    // Открываем все файлы и режем их на фрагменты по границам строк
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        results[i].errors.setMaxStored(maxErrorsPerFile_);
+        if (!files[i].open(filenames[i], fileMode_)) {
+            ParseError error;
+            error.kind = ParseErrorKind::FileOpen;
+            error.fileIndex = static_cast<uint32_t>(i);
+            results[i].errors.add(error);
+            continue;
+        }
+        splitIntoChunks(files[i].view(), i, chunks);
     }
     
-    std::string line;
-    int lineNumber = 0;
+    // Номер первой строки каждого фрагмента: считаем переводы строк в предыдущих
+    std::vector<int> newlineCounts(chunks.size(), 0);
+    runParallel(chunks.size(), [&](size_t c) {
+        bool hasNext = c + 1 < chunks.size() && chunks[c + 1].fileIndex == chunks[c].fileIndex;
+        if (hasNext) {
+            const char* begin = chunks[c].data.data();
+            newlineCounts[c] = static_cast<int>(TextScanner::countNewlines(begin, begin + chunks[c].data.size()));
+        }
+    });
+    for (size_t c = 1; c < chunks.size(); ++c) {
+        if (chunks[c].fileIndex == chunks[c - 1].fileIndex) {
+            chunks[c].firstLineNumber = chunks[c - 1].firstLineNumber + newlineCounts[c - 1];
+        }
+    }
     
-    while (std::getline(file, line)) {
-        lineNumber++;
-        result.totalLines++;
+    return chunks;
+}
+
+std::vector<DataParser::ParseResult> DataParser::parseFiles(const std::vector<std::string>& filenames,
+                                                            const std::vector<StudentTable*>& tables) {
+    std::vector<ParseResult> results(filenames.size());
+    std::vector<MappedFile> files(filenames.size());
+    std::vector<FileChunk> chunks = prepareChunks(filenames, files, results);
+    
+    // Разбор фрагментов на пуле потоков
+    std::vector<ParseResult> chunkResults(chunks.size());
+    std::vector<StudentTable> chunkTables(tables.empty() ? 0 : chunks.size());
+    runParallel(chunks.size(), [&](size_t c) {
+        ParseResult& result = chunkResults[c];
+        result.errors.setMaxStored(maxErrorsPerFile_);
+        ErrorSink errorSink = [&result](const ParseError& error) { result.errors.add(error); };
+        if (tables.empty()) {
+            parseBuffer(chunks[c], result,
+                        [&result](const Student& student) { result.students.push_back(student); },
+                        errorSink);
+        } else {
+            StudentTable& table = chunkTables[c];
+            parseBuffer(chunks[c], result,
+                        [&table](const Student& student) { table.append(student); },
+                        errorSink);
+        }
+    });
+    
+    // Склеиваем фрагменты в исходном порядке
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        ParseResult& target = results[chunks[c].fileIndex];
+        ParseResult& part = chunkResults[c];
         
-        // Пропускаем пустые строки и комментарии
-        std::string cleanedLine = cleanLine(line);
-        if (cleanedLine.empty()) {
+        target.totalLines += part.totalLines;
+        target.validLines += part.validLines;
+        target.students.insert(target.students.end(), part.students.begin(), part.students.end());
+        target.errors.append(part.errors);
+        
+        if (!tables.empty()) {
+            StudentTable* table = tables.size() == 1 ? tables[0] : tables[chunks[c].fileIndex];
+            table->appendTable(chunkTables[c]);
+        }
+    }
+    
+    return results;
+}
+
+std::vector<DataParser::ParseResult> DataParser::parseStudentFilesStreaming(
+        const std::vector<std::string>& filenames, const BatchConsumer& consumer) {
+    std::vector<ParseResult> results(filenames.size());
+    
+    std::mutex consumerMutex;
+    auto deliver = [&](ParseBatch& batch) {
+        if (batch.students.empty() && batch.errors.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(consumerMutex);
+            consumer(batch);
+        }
+        batch.students.clear();
+        batch.errors.clear();
+    };
+    
+    // Буфер на каждый поток; фрагменты очередного раунда ссылаются на них
+    std::vector<std::string> buffers(workerCount_);
+    std::string carry;
+    std::vector<FileChunk> chunks;
+    std::vector<ParseResult> chunkResults;
+    
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        ParseResult& target = results[i];
+        target.errors.setMaxStored(0);
+        // Сколько ошибок файла ещё можно передать потребителю
+        std::atomic<size_t> quota(maxErrorsPerFile_);
+        
+        // Ошибки чтения тоже уходят потребителю; в результатах остаются счётчики
+        auto reportFileError = [&](ParseErrorKind kind, size_t offset) {
+            ParseError error;
+            error.kind = kind;
+            error.fileIndex = static_cast<uint32_t>(i);
+            error.offset = offset;
+            target.errors.add(error);
+            if (quota > 0) {
+                quota--;
+                ParseBatch batch;
+                batch.fileIndex = i;
+                batch.errors.push_back(error);
+                deliver(batch);
+            }
+        };
+        
+        std::ifstream input(filenames[i], std::ios::binary | std::ios::ate);
+        if (!input) {
+            reportFileError(ParseErrorKind::FileOpen, 0);
             continue;
         }
+        std::streamoff fileSize = input.tellg();
+        input.seekg(0);
         
-        // Парсим строку
-        std::string errorMessage;
-        std::unique_ptr<Student> student= parseLine(cleanedLine, lineNumber, errorMessage);
+        size_t offset = 0;
+        int lineNumber = 1;
+        carry.clear();
+        bool more = true;
+        while (more) {
+            // Раунд: до workerCount_ фрагментов подряд, номера строк считаются при чтении
+            chunks.clear();
+            while (chunks.size() < buffers.size()) {
+                std::string& buffer = buffers[chunks.size()];
+                if (!readChunk(input, fileSize, buffer, carry)) {
+                    more = false;
+                    break;
+                }
+                FileChunk chunk;
+                chunk.fileIndex = i;
+                chunk.data = buffer;
+                chunk.offset = offset;
+                chunk.firstLineNumber = lineNumber;
+                chunks.push_back(chunk);
+                offset += buffer.size();
+                lineNumber += static_cast<int>(TextScanner::countNewlines(buffer.data(),
+                                                                          buffer.data() + buffer.size()));
+            }
+            
+            // Каждый поток держит не больше одной неполной порции
+            chunkResults.assign(chunks.size(), ParseResult());
+            runParallel(chunks.size(), [&](size_t c) {
+                const FileChunk& chunk = chunks[c];
+                ParseResult& result = chunkResults[c];
+                result.errors.setMaxStored(0);
+                
+                ParseBatch batch;
+                batch.fileIndex = chunk.fileIndex;
+                batch.students.reserve(batchSize_);
+                
+                parseBuffer(chunk, result,
+                            [&](const Student& student) {
+                                batch.students.append(student);
+                                if (batch.students.size() >= batchSize_) deliver(batch);
+                            },
+                            [&](const ParseError& error) {
+                                result.errors.add(error);
+                                size_t left = quota.load(std::memory_order_relaxed);
+                                while (left > 0 && !quota.compare_exchange_weak(left, left - 1)) {
+                                }
+                                if (left > 0) {
+                                    batch.errors.push_back(error);
+                                    if (batch.errors.size() >= batchSize_) deliver(batch);
+                                }
+                            });
+                deliver(batch);
+            });
+            
+            for (const ParseResult& part : chunkResults) {
+                target.totalLines += part.totalLines;
+                target.validLines += part.validLines;
+                target.errors.append(part.errors);
+            }
+        }
         
-        if (student && student->isValid()) {
-            result.students.push_back(*student);
-            result.validLines++;
-        } else {
-            result.errors.push_back("Файл " + filename + ", строка " + 
-                                  std::to_string(lineNumber) + ": " + errorMessage);
+        if (input.bad()) {
+            reportFileError(ParseErrorKind::FileRead, offset);
         }
     }
     
-    file.close();
-    return result;
+    return results;
 }
 
-std::vector<Student> DataParser::parseMultipleFiles(const std::vector<std::string>& filenames) {
-    std::vector<Student> allStudents;
+bool DataParser::readChunk(std::istream& input, std::streamoff fileSize,
+                           std::string& buffer, std::string& carry) const {
+    buffer.swap(carry);
+    carry.clear();
     
-    for (const std::string &filename : filenames) {
-        ParseResult result = parseStudentFile(filename);
+    while (input) {
+        // Порция не больше остатка файла (на байт больше, чтобы сразу увидеть конец):
+        // буфер не заполняется впустую для маленьких файлов
+        size_t step = chunkSize_;
+        std::streamoff position = input.tellg();
+        if (position >= 0) {
+            std::streamoff left = std::max<std::streamoff>(fileSize - position, MIN_READ_SIZE);
+            step = std::min(step, static_cast<size_t>(left) + 1);
+        }
+        size_t size = buffer.size();
+        buffer.resize(size + step);
+        input.read(&buffer[size], static_cast<std::streamsize>(step));
+        buffer.resize(size + static_cast<size_t>(input.gcount()));
         
-        // Выводим статистику по каждому файлу
-        printParseStatistics(result, filename);
+        // В перенесённом остатке и прошлых порциях перевода строки нет: ищем в новой
+        size_t newline = std::string_view(buffer).substr(size).rfind('\n');
+        if (newline != std::string_view::npos) {
+            if (input) {
+                carry.assign(buffer, size + newline + 1, std::string::npos);
+                buffer.resize(size + newline + 1);
+            }
+            break;
+        }
+    }
+    return !buffer.empty();
+}
+
+void DataParser::splitIntoChunks(std::string_view data, size_t fileIndex, std::vector<FileChunk>& chunks) const {
+    // Один поток - один фрагмент на файл
+    size_t chunkSize = workerCount_ > 1 ? chunkSize_ : data.size();
+    size_t begin = 0;
+    
+    do {
+        size_t end = data.size();
+        if (data.size() - begin > chunkSize) {
+            // Граница фрагмента - сразу после ближайшего перевода строки
+            size_t newline = data.find('\n', begin + chunkSize);
+            end = newline == std::string_view::npos ? data.size() : newline + 1;
+        }
+        
+        FileChunk chunk;
+        chunk.fileIndex = fileIndex;
+        chunk.data = data.substr(begin, end - begin);
+        chunk.offset = begin;
+        chunk.firstLineNumber = 1;
+        chunks.push_back(chunk);
         
-        // Добавляем валидных студентов
-        allStudents.insert(allStudents.end(), result.students.begin(), result.students.end());
+        begin = end;
+    } while (begin < data.size());
+}
+
+void DataParser::parseBuffer(const FileChunk& chunk, ParseResult& result,
+                             const StudentSink& sink, const ErrorSink& errorSink) {
+    TextScanner::LineTokenizer tokenizer(chunk.data);
+    TextScanner::Line line;
+    int lineNumber = chunk.firstLineNumber - 1;
+    Student student;
+    LineError lineError;
+    
+    while (tokenizer.next(line)) {
+        lineNumber++;
+        result.totalLines++;
         
-        // Выводим ошибки
-        for (const std::string &error : result.errors) {
-            std::cerr << "⚠️  " << error << std::endl;
+        // Пропускаем пустые строки и комментарии
+        if (isBlankOrComment(line)) {
+            continue;
+        }
+        
+        // Парсим строку; для ошибки запоминаются положение и начало ошибочного поля
+        if (parseLine(line, student, lineError)) {
+            sink(student);
+            result.validLines++;
+        } else {
+            const size_t maxField = UINT16_MAX;
+            size_t column = lineError.field.empty() ? 0 : lineError.field.data() - line.text.data();
+            
+            ParseError error;
+            error.kind = lineError.kind;
+            error.fileIndex = static_cast<uint32_t>(chunk.fileIndex);
+            error.line = static_cast<uint32_t>(lineNumber);
+            error.offset = chunk.offset + (line.text.data() - chunk.data.data());
+            error.column = static_cast<uint16_t>(std::min(column, maxField));
+            error.setField(lineError.field);
+            errorSink(error);
         }
     }
-    
-    return allStudents;
 }
 
-std::string DataParser::cleanLine(const std::string& line) {
-    std::string cleaned = trim(line);
+std::vector<DataParser::ParseResult> DataParser::parseStudentFiles(const std::vector<std::string>& filenames) {
+    return parseFiles(filenames, {});
+}
+
+std::vector<Student> DataParser::parseMultipleFiles(const std::vector<std::string>& filenames) {
+    std::vector<ParseResult> results = parseStudentFiles(filenames);
     
-    // Пропускаем строки, начинающиеся с комментариев
-    if (cleaned.empty() || cleaned[0] == '#' || cleaned[0] == ';') {
-        return "";
+    size_t totalStudents = 0;
+    for (const ParseResult& result : results) {
+        totalStudents += result.students.size();
     }
     
-    // Удаляем лишние пробелы между словами
-    std::stringstream ss(cleaned);
-    std::string token, result;
-    while (ss >> token) {
-        if (!result.empty()) result += " ";
-        result += token;
+    std::vector<Student> allStudents;
+    allStudents.reserve(totalStudents);
+    
+    // Статистика и данные собираются в порядке файлов
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        reportParseResult(results[i], filenames[i]);
+        allStudents.insert(allStudents.end(), results[i].students.begin(), results[i].students.end());
     }
     
-    return result;
+    return allStudents;
 }
 
-std::vector<std::string> DataParser::tokenizeLine(const std::string& line, int lineNumber, std::string& errorMessage) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(line);
-    std::string token;
+StudentTable DataParser::parseMultipleFilesToTable(const std::vector<std::string>& filenames) {
+    // Все файлы дописываются в одну таблицу в порядке filenames
+    StudentTable table;
+    std::vector<ParseResult> results = parseFiles(filenames, {&table});
     
-    while (ss >> token) {
-        tokens.push_back(token);
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        reportParseResult(results[i], filenames[i]);
     }
-        // Проверяем минимальное количество токенов (ID, Фамилия, Имя, Дата)
-    if (tokens.size() < 4) {
-        errorMessage = "Недостаточно данных. Ожидается: ID Фамилия Имя [Отчество] ДатаРождения";
-        return {};
+    
+    return table;
+}
+
+void DataParser::runParallel(size_t taskCount, const std::function<void(size_t)>& task) const {
+    size_t threadCount = std::min(workerCount_, taskCount);
+    if (threadCount <= 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
     }
     
-    // Обрабатываем разные случаи количества токенов
-    if (tokens.size() == 4) {
-        // Нет отчества: ID Фамилия Имя Дата
-        tokens.insert(tokens.begin() + 3, ""); // Вставляем пустое отчество
-    } else if (tokens.size() == 5) {
-        // Есть отчество: ID Фамилия Имя Отчество Дата
-        // Ничего не меняем
-    } else if (tokens.size() > 5) {
-        // Если больше 5 токенов, возможно, в ФИО есть пробелы
-        // Объединяем токены с 3 по предпоследний как отчество
-        std::string patronymic = tokens[3];
-        for (size_t i = 4; i < tokens.size() - 1; ++i) {
-            patronymic += " " + tokens[i];
+    std::atomic<size_t> nextTask(0);
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    
+    auto worker = [&]() {
+        for (size_t i = nextTask++; i < taskCount; i = nextTask++) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) failure = std::current_exception();
+            }
         }
-        tokens[3] = patronymic;
-        tokens.resize(5); // Оставляем только 5 токенов
+    };
+    
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker(); // вызывающий поток тоже участвует в работе
+    
+    for (std::thread& thread : threads) {
+        thread.join();
     }
     
-    return tokens;
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
 }
 
-std::unique_ptr<Student> DataParser::parseLine(const std::string& line, int lineNumber, std::string& errorMessage) {
-
-    std::vector<std::string> tokens = tokenizeLine(line, lineNumber, errorMessage);
-    if (tokens.empty()) {
-        return nullptr;
+void DataParser::reportParseResult(const ParseResult& result, const std::string& filename) const {
+    // Выводим статистику по каждому файлу
+    printParseStatistics(result, filename);
+    
+    // Выводим первые ошибки; текст строится только здесь
+    for (const std::string& error : result.errors.format(filename)) {
+        std::cerr << "⚠️  " << error << std::endl;
+    }
+    if (result.errors.dropped() > 0) {
+        std::cerr << "⚠️  ... и ещё ошибок: " << result.errors.dropped() << std::endl;
     }
+}
 
-    int id;
-    try {
-        id = std::stoi(tokens[0]);
-        if (id < 0) {
-            errorMessage = "ID не может быть отрицательным: " + tokens[0];
-            return nullptr;
-        }
-    } catch (const std::exception& e) {
-        errorMessage = "Неверный формат ID: " + tokens[0];
-        return nullptr;
+bool DataParser::isBlankOrComment(const TextScanner::Line& line) const {
+    // Строки, начинающиеся с комментариев, пропускаются
+    return line.tokenCount == 0 || line.comment;
+}
+
+bool DataParser::tokenizeLine(const TextScanner::Line& line, LineTokens& tokens, LineError& error) const {
+    // Проверяем минимальное количество токенов (ID, Фамилия, Имя, Дата)
+    if (line.tokenCount < 4) {
+        error = {ParseErrorKind::MissingFields, std::string_view()};
+        return false;
     }
     
-
-    std::string lastName = tokens[1];
-    std::string firstName = tokens[2];
-    std::string patronymic = tokens[3];
-    std::string birthDate = tokens[4];
+    // Первые три токена и последний; всё между ними - отчество
+    tokens.id = line.head[0];
+    tokens.lastName = line.head[1];
+    tokens.firstName = line.head[2];
+    tokens.birthDate = line.tail;
+    
+    if (line.tokenCount > 4) {
+        const char* begin = line.head[2].data() + line.head[2].size();
+        tokens.patronymic = TextScanner::trim(std::string_view(begin, line.tail.data() - begin));
+    } else {
+        tokens.patronymic = std::string_view();
+    }
     
-    return createStudent(id, firstName, lastName, patronymic, birthDate, errorMessage);
+    return true;
 }
 
-std::unique_ptr<Student> DataParser::createStudent(int id, const std::string& firstName, 
-                                                 const std::string& lastName, const std::string& patronymic,
-                                                 const std::string& birthDate, std::string& errorMessage) {
-    std::unique_ptr<Student> student = std::make_unique<Student>();
-    
-    if (!student->setId(id)) {
-        errorMessage = "Неверный ID: " + std::to_string(id);
-        return nullptr;
+bool DataParser::parseLine(const TextScanner::Line& line, Student& student, LineError& error) {
+    LineTokens tokens;
+    if (!tokenizeLine(line, tokens, error)) {
+        return false;
+    }
+
+    int id = 0;
+    std::from_chars_result parsed = std::from_chars(tokens.id.data(), tokens.id.data() + tokens.id.size(), id);
+    if (parsed.ec != std::errc()) {
+        error = {ParseErrorKind::InvalidId, tokens.id};
+        return false;
     }
+    if (id < 0) {
+        error = {ParseErrorKind::NegativeId, tokens.id};
+        return false;
+    }
+    
+    return createStudent(id, tokens.firstName, tokens.lastName, tokens.patronymic,
+                         tokens.birthDate, student, error);
+}
+
+bool DataParser::createStudent(int id, std::string_view firstName, std::string_view lastName,
+                               std::string_view patronymic, std::string_view birthDate,
+                               Student& student, LineError& error) {
+    (void)patronymic; // отчество в Student не хранится
     
-    if (!student->setLastName(lastName)) {
-        errorMessage = "Неверная фамилия: '" + lastName + "'";
-        return nullptr;
+    if (id < 0) {
+        error = {ParseErrorKind::NegativeId, std::string_view()};
+        return false;
     }
     
-    if (!student->setFirstName(firstName)) {
-        errorMessage = "Неверное имя: '" + firstName + "'";
-        return nullptr;
+    if (lastName.empty() || !Student::isValidName(lastName)) {
+        error = {ParseErrorKind::InvalidLastName, lastName};
+        return false;
     }
     
-    if (!student->setBirthDate(birthDate)) {
-        errorMessage = "Неверная дата рождения: '" + birthDate + "'";
-        return nullptr;
+    if (firstName.empty() || !Student::isValidName(firstName)) {
+        error = {ParseErrorKind::InvalidFirstName, firstName};
+        return false;
     }
     
-    if (!student->isValid()) {
-        errorMessage = "Невалидные данные студента";
-        return nullptr;
+    Date date;
+    if (!Date::parse(birthDate, date)) {
+        error = {ParseErrorKind::InvalidBirthDate, birthDate};
+        return false;
     }
     
-    return student;
+    // Все поля проверены - только теперь интернируем имена и создаём запись
+    student = Student(id, firstName, lastName, date);
+    return true;
 }
 
 void DataParser::printParseStatistics(const ParseResult& result, const std::string& filename) const {
     std::cout << "   Результаты парсинга файла: " << filename << std::endl;
     std::cout << "   Всего строк: " << result.totalLines << std::endl;
     std::cout << "   Валидных записей: " << result.validLines << std::endl;
-    std::cout << "   Ошибок: " << result.errors.size() << std::endl;
+    std::cout << "   Ошибок: " << result.errors.total() << std::endl;
+    for (size_t i = 0; i < ParseErrorLog::KIND_COUNT; ++i) {
+        ParseErrorKind kind = static_cast<ParseErrorKind>(i);
+        if (result.errors.count(kind) > 0) {
+            std::cout << "     " << ParseErrorLog::kindName(kind) << ": " << result.errors.count(kind) << std::endl;
+        }
+    }
     
     if (result.validLines > 0) {
-        std::cout << "   Успешно загружено студентов: " << result.students.size() << std::endl;
+        std::cout << "   Успешно загружено студентов: " << result.validLines << std::endl;
     }
     std::cout << std::endl;
 }
\ No newline at end of file
@@ -2,38 +2,173 @@
 #define DATA_PARSER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <fstream> 
+#include <functional>
 #include "../common/student.hpp"
+#include "../common/student_table.hpp"
+#include "text_scanner.hpp"
+#include "mapped_file.hpp"
+#include "parse_error.hpp"
 
 class DataParser {
 public:
+    // workerCount - число потоков для разбора; 0 - по числу ядер
+    explicit DataParser(size_t workerCount = 1);
+    
+    void setWorkerCount(size_t workerCount);
+    size_t getWorkerCount() const { return workerCount_; }
+    
+    // Файлы больше chunkSize байт разбираются несколькими потоками по фрагментам;
+    // потоковый разбор читает файлы фрагментами по chunkSize байт
+    void setChunkSize(size_t chunkSize);
+    size_t getChunkSize() const { return chunkSize_; }
+    
+    // Сколько ошибок на файл сохраняется для вывода (остальные только подсчитываются)
+    void setMaxErrorsPerFile(size_t maxErrors) { maxErrorsPerFile_ = maxErrors; }
+    size_t getMaxErrorsPerFile() const { return maxErrorsPerFile_; }
+    
+    // Способ загрузки файлов (по умолчанию чтение в буфер). Отображение без копии
+    // годится только для файлов, которые не меняются во время разбора: укороченный
+    // другим процессом отображённый файл завершает процесс сигналом SIGBUS.
+    // Потоковый разбор файлы целиком не загружает и режим не использует
+    void setFileMode(MappedFile::Mode mode) { fileMode_ = mode; }
+    MappedFile::Mode getFileMode() const { return fileMode_; }
+    
     struct ParseResult {
         std::vector<Student> students;
-        std::vector<std::string> errors;
+        ParseErrorLog errors;
         int totalLines;
         int validLines;
         
         ParseResult() : totalLines(0), validLines(0) {}
     };
 
+    // Порция записей потокового разбора
+    struct ParseBatch {
+        size_t fileIndex;                  // индекс файла в списке filenames
+        StudentTable students;
+        std::vector<ParseError> errors;
+        
+        ParseBatch() : fileIndex(0) {}
+    };
+    
+    // Потребитель порций; вызовы никогда не выполняются одновременно.
+    // Порция принадлежит парсеру и очищается после возврата из потребителя
+    using BatchConsumer = std::function<void(ParseBatch& batch)>;
+    
+    // Максимальное число записей (и ошибок) в одной порции.
+    // Ошибок на файл передаётся не больше maxErrorsPerFile
+    void setBatchSize(size_t batchSize);
+    size_t getBatchSize() const { return batchSize_; }
+
     ParseResult parseStudentFile(const std::string& filename);
     
+    // Разбор файла сразу в колоночную таблицу: валидные записи дописываются в table,
+    // в результате остаются только статистика и ошибки
+    ParseResult parseStudentFile(const std::string& filename, StudentTable& table);
+    
+    // Параллельный разбор файлов; результаты в том же порядке, что и filenames
+    std::vector<ParseResult> parseStudentFiles(const std::vector<std::string>& filenames);
+    
+    // Потоковый разбор: записи и ошибки передаются consumer порциями по batchSize,
+    // пока разбор ещё идёт. Файлы читаются по одному, фрагментами примерно по
+    // chunkSize байт до границы строки; потоки разбирают очередные workerCount
+    // фрагментов. В памяти парсера не больше workerCount фрагментов (строка длиннее
+    // chunkSize читается целиком) и batchSize записей на поток, независимо от
+    // размера файлов. Внутри фрагмента порядок сохраняется, порции разных
+    // фрагментов при нескольких потоках могут чередоваться.
+    // В результатах остаются только счётчики строк и ошибок
+    std::vector<ParseResult> parseStudentFilesStreaming(const std::vector<std::string>& filenames,
+                                                        const BatchConsumer& consumer);
+    
     std::vector<Student> parseMultipleFiles(const std::vector<std::string>& filenames);
     
+    StudentTable parseMultipleFilesToTable(const std::vector<std::string>& filenames);
+    
     void printParseStatistics(const ParseResult& result, const std::string& filename) const;
 
 private:
-    std::unique_ptr<Student> parseLine(const std::string& line, int lineNumber, std::string& errorMessage);
+    using StudentSink = std::function<void(const Student&)>;
+    using ErrorSink = std::function<void(const ParseError&)>;
     
-    std::unique_ptr<Student> createStudent(int id, const std::string& firstName, 
-                                         const std::string& lastName, const std::string& patronymic,
-                                         const std::string& birthDate, std::string& errorMessage);
+    // Поля строки как представления над исходным буфером (без копирования)
+    struct LineTokens {
+        std::string_view id;
+        std::string_view lastName;
+        std::string_view firstName;
+        std::string_view patronymic;
+        std::string_view birthDate;
+    };
     
-    std::string cleanLine(const std::string& line);
+    // Ошибка в строке: вид и ошибочное поле
+    struct LineError {
+        ParseErrorKind kind;
+        std::string_view field;
+    };
+    
+    // Фрагмент файла, выровненный по границам строк
+    struct FileChunk {
+        size_t fileIndex;
+        std::string_view data;
+        size_t offset;              // смещение фрагмента в файле
+        int firstLineNumber;
+    };
+    
+    // Общий путь разбора: все файлы режутся на фрагменты и разбираются на пуле.
+    // Если tables пуст, записи собираются в ParseResult::students; иначе дописываются
+    // в tables[i] для файла i (или в tables[0], если таблица одна на все файлы)
+    std::vector<ParseResult> parseFiles(const std::vector<std::string>& filenames,
+                                        const std::vector<StudentTable*>& tables);
+    
+    // Загружает файлы в память и режет их на фрагменты с номерами первых строк.
+    // Ошибки открытия записываются в results
+    std::vector<FileChunk> prepareChunks(const std::vector<std::string>& filenames,
+                                         std::vector<MappedFile>& files,
+                                         std::vector<ParseResult>& results) const;
+    
+    void splitIntoChunks(std::string_view data, size_t fileIndex, std::vector<FileChunk>& chunks) const;
+    
+    // Следующий фрагмент потокового чтения: buffer начинается с перенесённого
+    // остатка carry, дочитывается порциями по chunkSize до перевода строки и
+    // обрезается после последнего из них; неполная строка уходит в carry.
+    // fileSize - размер файла при открытии. false - файл закончился
+    bool readChunk(std::istream& input, std::streamoff fileSize,
+                   std::string& buffer, std::string& carry) const;
+    
+    // Разбор фрагмента файла
+    void parseBuffer(const FileChunk& chunk, ParseResult& result,
+                     const StudentSink& sink, const ErrorSink& errorSink);
+    
+    void reportParseResult(const ParseResult& result, const std::string& filename) const;
+    
+    // Выполняет task(0..taskCount-1) на пуле из не более чем workerCount_ потоков
+    void runParallel(size_t taskCount, const std::function<void(size_t)>& task) const;
+    
+    bool parseLine(const TextScanner::Line& line, Student& student, LineError& error);
+    
+    // Запись создаётся только после успешной проверки всех полей
+    bool createStudent(int id, std::string_view firstName, std::string_view lastName,
+                       std::string_view patronymic, std::string_view birthDate,
+                       Student& student, LineError& error);
+    
+    bool isBlankOrComment(const TextScanner::Line& line) const;
+    
+    bool tokenizeLine(const TextScanner::Line& line, LineTokens& tokens, LineError& error) const;
+    
+private:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t DEFAULT_BATCH_SIZE = 4096;
+    // Наименьшая порция чтения, в том числе для файла, выросшего после открытия
+    static constexpr size_t MIN_READ_SIZE = 64 * 1024;
     
-    std::vector<std::string> tokenizeLine(const std::string& line, int lineNumber, std::string& errorMessage);
+    size_t workerCount_;
+    size_t chunkSize_;
+    size_t batchSize_;
+    size_t maxErrorsPerFile_;
+    MappedFile::Mode fileMode_;
 };
 
 #endif // DATA_PARSER_HPP
\ No newline at end of file
@@ -7,12 +7,20 @@
 #include <thread>
 #include <chrono>
 #include <unordered_map>
+#include <map>
 #include <filesystem>
 #include <fstream>
 #include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <future>
 #include "data_parser.hpp"
 #include "data_manager.hpp"
 #include "../common/zmq_publisher.hpp"
+#include "../common/student_shard.hpp"
+#include "../common/binary_serializer.hpp"
+#include "../common/payload_codec.hpp"
 
 namespace fs = std::filesystem;
 
@@ -23,7 +31,16 @@ private:
     ZmqPublisher publisher_;
     std::string database_dir_;
     std::unordered_map<std::string, fs::file_time_type> file_timestamps_;
-    bool first_run_ = true;   // <-- флаг для первой отправки
+    // Разбиение на темы: клиенты подписываются только на нужные шарды
+    StudentSharder::Mode shard_mode_;
+    int id_range_;
+    // Сжатие сообщений; словарь читается из файла или обучается в фоне на первых данных
+    bool compress_;
+    std::string dictionary_path_;
+    std::future<std::string> dictionary_training_;
+    static constexpr size_t DICTIONARY_SAMPLE_RECORDS = 64;
+    static constexpr size_t MAX_DICTIONARY_SAMPLE_BYTES = 4 * 1024 * 1024;
+    static constexpr char DEFAULT_DICTIONARY_FILE[] = "students.dict";
 
     // Проверяет новые или изменённые файлы и возвращает список их путей
     std::vector<std::string> detectChangedFiles() {
@@ -50,51 +67,239 @@ private:
         return changed_files;
     }
 
-    void processAndPublish(const std::vector<std::string>& files) {
-        if (files.empty()) return;
+    // Проверяет исчезнувшие файлы и возвращает список их путей
+    std::vector<std::string> detectRemovedFiles() {
+        std::vector<std::string> removed_files;
 
-        // Если это первая отправка – даём клиентам 5 секунд на подключение
-        if (first_run_) {
-            std::cout << "\n[INFO] Первая отправка. Ожидание 5 секунд для подключения клиентов..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-            first_run_ = false;
+        for (auto it = file_timestamps_.begin(); it != file_timestamps_.end();) {
+            if (fs::exists(it->first)) {
+                ++it;
+                continue;
+            }
+            removed_files.push_back(it->first);
+            it = file_timestamps_.erase(it);
+        }
+
+        return removed_files;
+    }
+
+    // Примеры для обучения словаря - небольшие части снимка: похожи и на снимки, и на
+    // изменения. Части берутся равномерно по всему списку, в сумме не больше
+    // MAX_DICTIONARY_SAMPLE_BYTES: больше zstd не нужно, а время обучения растёт
+    static std::vector<std::string> collectDictionarySamples(const StudentTable& students) {
+        std::vector<std::string> samples;
+        size_t slices = (students.size() + DICTIONARY_SAMPLE_RECORDS - 1) / DICTIONARY_SAMPLE_RECORDS;
+        if (slices == 0) return samples;
+
+        std::string first;
+        BinarySerializer::serializeSnapshotChunk(students, 0, std::min(DICTIONARY_SAMPLE_RECORDS, students.size()),
+                                                 1, 0, 1, first);
+        size_t wanted = std::max<size_t>(1, MAX_DICTIONARY_SAMPLE_BYTES / std::max<size_t>(first.size(), 1));
+        size_t stride = std::max<size_t>(1, slices / wanted);
+
+        size_t bytes = 0;
+        for (size_t slice = 0; slice < slices && bytes < MAX_DICTIONARY_SAMPLE_BYTES; slice += stride) {
+            size_t begin = slice * DICTIONARY_SAMPLE_RECORDS;
+            size_t end = std::min(begin + DICTIONARY_SAMPLE_RECORDS, students.size());
+            samples.emplace_back();
+            BinarySerializer::serializeSnapshotChunk(students, begin, end, 1, 0, 1, samples.back());
+            bytes += samples.back().size();
+        }
+        return samples;
+    }
+
+    // Словарь из файла (по умолчанию students.dict в каталоге данных). Если файла нет,
+    // словарь обучается в фоне на текущих данных и сохраняется, чтобы следующий запуск
+    // использовал тот же словарь; до конца обучения сообщения уходят без сжатия
+    void setupCompression(const StudentStore& store) {
+        if (!compress_ || publisher_.getCodec()) return;
+        if (!PayloadCodec::available()) {
+            std::cerr << "[WARN] Сервер собран без zstd, сообщения не сжимаются" << std::endl;
+            compress_ = false;
+            return;
         }
 
+        std::string dictionary;
+        if (dictionary_training_.valid()) {
+            if (dictionary_training_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+            dictionary = dictionary_training_.get();
+            if (dictionary.empty()) {
+                std::cerr << "[WARN] Мало данных для словаря, сжатие без словаря" << std::endl;
+            } else {
+                std::ofstream file(dictionary_path_, std::ios::binary);
+                file.write(dictionary.data(), static_cast<std::streamsize>(dictionary.size()));
+            }
+        } else if (fs::exists(dictionary_path_)) {
+            std::ifstream file(dictionary_path_, std::ios::binary);
+            dictionary.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        } else {
+            // Примеры собираются здесь (не больше нескольких МБ), обучение - в отдельном потоке
+            std::cout << "[INFO] Словарь " << dictionary_path_ << " не найден, обучение в фоне" << std::endl;
+            dictionary_training_ = std::async(std::launch::async,
+                [samples = collectDictionarySamples(store.table())] {
+                    return PayloadCodec::trainDictionary(samples);
+                });
+            return;
+        }
+
+        auto codec = std::make_shared<const PayloadCodec>(std::move(dictionary));
+        std::cout << "[INFO] Сжатие zstd, словарь " << codec->dictionaryId()
+                  << " (" << codec->dictionary().size() << " байт)" << std::endl;
+        publisher_.setCodec(std::move(codec));
+    }
+
+    void processAndPublish(const std::vector<std::string>& files,
+                           const std::vector<std::string>& removed_files) {
+        if (files.empty() && removed_files.empty()) return;
+
         std::cout << "\n[INFO] Изменения обнаружены, обработка файлов..." << std::endl;
 
-        std::vector<Student> students = parser_.parseMultipleFiles(files);
-        if (students.empty()) {
-            std::cerr << "[WARN] Не удалось загрузить данные из изменённых файлов" << std::endl;
+        // Записи приходят порциями: проверка выполняется, пока разбор ещё идёт,
+        // в памяти остаются только валидные строки
+        std::vector<StudentTable> tables(files.size());
+        std::vector<ParseErrorLog> error_logs(files.size());
+        std::vector<DataParser::ParseResult> stats =
+            parser_.parseStudentFilesStreaming(files, [&](DataParser::ParseBatch& batch) {
+                tables[batch.fileIndex].appendTable(data_manager_.filterValidStudents(batch.students));
+                for (const ParseError& error : batch.errors) {
+                    error_logs[batch.fileIndex].add(error);
+                }
+            });
+
+        // Тексты ошибок строятся только для первых ошибок каждого файла
+        for (size_t i = 0; i < files.size(); ++i) {
+            parser_.printParseStatistics(stats[i], files[i]);
+            for (const std::string& error : error_logs[i].format(files[i])) {
+                std::cerr << "⚠️  " << error << std::endl;
+            }
+            if (stats[i].errors.total() > error_logs[i].total()) {
+                std::cerr << "⚠️  ... и ещё ошибок: "
+                          << stats[i].errors.total() - error_logs[i].total() << std::endl;
+            }
+        }
+        // Изменённый файл заменяет только свою часть общего списка: в хранилище
+        // меняются лишь отличающиеся записи, дубликаты и порядок поддерживаются им же
+        StudentStore& store = data_manager_.store();
+        // Записи удалённых файлов исключаются из опубликованного списка
+        for (const std::string& file : removed_files) {
+            store.removeSource(file);
+            std::cout << "[INFO] " << file << ": файл удалён" << std::endl;
+        }
+        size_t applied = removed_files.size();
+        for (size_t i = 0; i < files.size(); ++i) {
+            // Файл не открылся или не дочитан: прежние записи остаются, а отметка
+            // времени сбрасывается, чтобы следующий опрос прочитал файл снова.
+            // Записи снимаются только с файла, которого действительно больше нет
+            bool unreadable = stats[i].errors.count(ParseErrorKind::FileOpen) > 0 ||
+                              stats[i].errors.count(ParseErrorKind::FileRead) > 0;
+            if (unreadable) {
+                if (fs::exists(files[i])) {
+                    file_timestamps_[files[i]] = fs::file_time_type::min();
+                    std::cerr << "[WARN] " << files[i] << ": файл не прочитан, повтор при следующей проверке"
+                              << std::endl;
+                    continue;
+                }
+                file_timestamps_.erase(files[i]);
+                store.removeSource(files[i]);
+                applied++;
+                std::cout << "[INFO] " << files[i] << ": файл удалён" << std::endl;
+                continue;
+            }
+            StudentStore::Change change = store.replaceSource(files[i], tables[i]);
+            applied++;
+            std::cout << "[INFO] " << files[i] << ": +" << change.added << " -" << change.removed
+                      << " ~" << change.updated << std::endl;
+        }
+        if (applied == 0) return;
+
+        // Изменение списка строится по записям, которые хранилище поменяло, без
+        // сборки и сравнения полного списка. Забирается при каждой правке, чтобы
+        // в хранилище не копились изменения для режимов с темами
+        StudentDelta changes = store.takeDelta();
+
+        // Пустой список после удаления или правки файлов тоже публикуется,
+        // иначе подписчики остались бы с устаревшими данными
+        if (store.empty()) {
+            std::cerr << "[WARN] Нет валидных записей в файлах" << std::endl;
+            if (publisher_.getTopicCount() == 0) return;
+        } else {
+            setupCompression(store);
+        }
+
+        // Клиентам уходит только разница с предыдущей версией
+        if (shard_mode_ == StudentSharder::Mode::None) {
+            std::cout << "[INFO] Отправка данных. Студентов: " << store.size()
+                      << ", изменено: " << changes.size() << std::endl;
+            publisher_.publishDelta(changes);
+            std::cout << "[INFO] Версия " << publisher_.getVersion()
+                      << " (снимков: " << publisher_.getSnapshotsSent()
+                      << ", изменений: " << publisher_.getDeltasSent() << ")" << std::endl;
+            printCompression();
             return;
         }
 
-        students = data_manager_.filterValidStudents(students);
-        students = data_manager_.removeDuplicates(students);
-        students = data_manager_.sortStudentsByName(students);
+        // Каждая тема ведёт свою цепочку версий: изменение одного файла или
+        // диапазона не затрагивает подписчиков остальных тем
+        std::map<std::string, StudentTable> shards;
+        if (shard_mode_ == StudentSharder::Mode::SourceFile) {
+            for (auto& source : store.tablesBySource()) {
+                shards[StudentSharder::fileTopic(source.first)] = std::move(source.second);
+            }
+        } else {
+            shards = StudentSharder::shard(store.table(), shard_mode_, id_range_);
+        }
+        std::cout << "[INFO] Отправка данных. Тем: " << shards.size() << std::endl;
+        publisher_.publishShards(shards);
+        std::cout << "[INFO] Тем у издателя: " << publisher_.getTopicCount()
+                  << " (снимков: " << publisher_.getSnapshotsSent()
+                  << ", изменений: " << publisher_.getDeltasSent() << ")" << std::endl;
+        printCompression();
+    }
 
-        std::cout << "[INFO] Отправка данных. Студентов: " << students.size() << std::endl;
-        publisher_.publish(students);
+    void printCompression() {
+        if (publisher_.getBytesAfterCompression() == 0) return;
+        std::cout << "[INFO] Сжатие: " << publisher_.getBytesBeforeCompression() << " -> "
+                  << publisher_.getBytesAfterCompression() << " байт" << std::endl;
     }
 
 public:
-    StudentServer(const std::string& database_dir = "../database")
-        : database_dir_(database_dir) {}
+    StudentServer(const std::string& database_dir = "../database",
+                  StudentSharder::Mode shard_mode = StudentSharder::Mode::None,
+                  int id_range = StudentSharder::DEFAULT_ID_RANGE,
+                  bool compress = false, const std::string& dictionary_path = "")
+        : parser_(0 /* потоков по числу ядер */), database_dir_(database_dir),
+          shard_mode_(shard_mode), id_range_(id_range),
+          compress_(compress),
+          dictionary_path_(dictionary_path.empty() ? database_dir + "/" + DEFAULT_DICTIONARY_FILE
+                                                   : dictionary_path) {}
 
     bool run() {
         std::cout << "Сервер обработки студентов" << std::endl;
         std::cout << "==========================" << std::endl;
 
-        if (!publisher_.start("tcp://*:5556")) {
+        // Клиенты, подключившиеся позже, получают текущий снимок по запросу
+        if (!publisher_.start("tcp://*:5556", "tcp://*:5555")) {
             std::cerr << "[ERROR] Ошибка запуска ZMQ publisher" << std::endl;
             return false;
         }
 
+        // Клиенты определяют формат по заголовку сообщения
+        publisher_.setFormat(Serializer::Format::Binary);
+        // Клиентам важна только последняя версия списка: при медленной сети
+        // неотправленные версии заменяются новой
+        publisher_.setBackpressurePolicy(ZmqPublisher::BackpressurePolicy::KeepLatest);
+
         std::cout << "[INFO] Мониторинг директории: " << database_dir_ << std::endl;
 
         while (true) {
             try {
                 std::vector<std::string> changed_files = detectChangedFiles();
-                processAndPublish(changed_files);
+                std::vector<std::string> removed_files = detectRemovedFiles();
+                processAndPublish(changed_files, removed_files);
+                // Словарь, обученный в фоне, сохраняется и включается, не дожидаясь изменений
+                if (dictionary_training_.valid()) {
+                    setupCompression(data_manager_.store());
+                }
             } catch (const std::exception& ex) {
                 std::cerr << "[ERROR] " << ex.what() << std::endl;
             }
@@ -108,7 +313,63 @@ public:
     }
 };
 
-int main() {
-    StudentServer server;
+void printUsage(const std::string& program_name) {
+    std::cout << "Использование: " << program_name << " [опции]" << std::endl;
+    std::cout << "Опции:" << std::endl;
+    std::cout << "  --shard <режим>         Разбиение на темы: none, file, id, initial (по умолчанию: none)" << std::endl;
+    std::cout << "  --id-range <число>      Размер диапазона ID для режима id (по умолчанию: "
+              << StudentSharder::DEFAULT_ID_RANGE << ")" << std::endl;
+    std::cout << "  --compress              Сжимать сообщения zstd со словарём" << std::endl;
+    std::cout << "  --dictionary <файл>     Словарь сжатия (по умолчанию: <каталог данных>/students.dict);" << std::endl;
+    std::cout << "                          если файла нет, словарь обучается в фоне и сохраняется" << std::endl;
+    std::cout << "  -h, --help              Показать эту справку" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    StudentSharder::Mode shard_mode = StudentSharder::Mode::None;
+    int id_range = StudentSharder::DEFAULT_ID_RANGE;
+    bool compress = false;
+    std::string dictionary_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (arg == "--compress") {
+            compress = true;
+            continue;
+        }
+        if (arg != "--shard" && arg != "--id-range" && arg != "--dictionary") {
+            std::cerr << "Неизвестный аргумент: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Ошибка: отсутствует значение для " << arg << std::endl;
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--shard") {
+            if (!StudentSharder::parseMode(value, shard_mode)) {
+                std::cerr << "Ошибка: неизвестный режим разбиения " << value << std::endl;
+                return 1;
+            }
+        } else if (arg == "--dictionary") {
+            dictionary_path = value;
+            compress = true;
+        } else {
+            id_range = std::atoi(value.c_str());
+            if (id_range <= 0) {
+                std::cerr << "Ошибка: размер диапазона должен быть положительным" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    StudentServer server("../database", shard_mode, id_range, compress, dictionary_path);
     return server.run() ? 0 : 1;
 }
\ No newline at end of file
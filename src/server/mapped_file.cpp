@@ -0,0 +1,133 @@
+/*
+ * Загрузка файлов данных в память для парсера
+ * Позволяет разбирать строки прямо по байтам файла без промежуточных копий
+ */
+
+#include "mapped_file.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), open_(false), mapped_(false) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_), open_(other.open_), mapped_(other.mapped_),
+      buffer_(std::move(other.buffer_)) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = false;
+    other.mapped_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        open_ = other.open_;
+        mapped_ = other.mapped_;
+        buffer_ = std::move(other.buffer_);
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.open_ = false;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename, Mode mode) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(info.st_size);
+    bool loaded = mode == Mode::Map ? map(fd) : read(fd);
+
+    // Отображение остаётся валидным и после закрытия дескриптора
+    ::close(fd);
+    if (!loaded) {
+        close();
+        return false;
+    }
+    open_ = true;
+    return true;
+}
+
+bool MappedFile::map(int fd) {
+    if (size_ == 0) {
+        return true;
+    }
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        size_ = 0;
+        return false;
+    }
+    // Файл читается один раз от начала до конца
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(mapped);
+    mapped_ = true;
+    return true;
+}
+
+bool MappedFile::read(int fd) {
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Размер из fstat - только оценка: файл может измениться во время чтения.
+    // Лишний байт позволяет заметить конец файла без перевыделения
+    size_t capacity = size_ + 1;
+    std::unique_ptr<char[]> buffer(new char[capacity]);
+    size_t size = 0;
+    while (true) {
+        if (size == capacity) {
+            std::unique_ptr<char[]> grown(new char[capacity * 2]);
+            std::memcpy(grown.get(), buffer.get(), size);
+            buffer = std::move(grown);
+            capacity *= 2;
+        }
+        ssize_t count = ::read(fd, buffer.get() + size, capacity - size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            size_ = 0;
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        size += static_cast<size_t>(count);
+    }
+
+    buffer_ = std::move(buffer);
+    data_ = buffer_.get();
+    size_ = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_ && data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+    buffer_.reset();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
@@ -0,0 +1,54 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstddef>
+
+// Содержимое файла в памяти только для чтения: отображение (POSIX mmap) или
+// копия, прочитанная read() в собственный буфер.
+// Содержимое доступно как std::string_view без дальнейших копий.
+//
+// Отображение безопасно только для файлов, которые никто не меняет: если другой
+// процесс укоротит файл, обращение к странице за его новым концом завершит
+// процесс сигналом SIGBUS, и ни MAP_POPULATE, ни повторная проверка размера от
+// этого не защищают. Файлы отслеживаемого каталога читаются в буфер (Mode::Read):
+// укороченный во время чтения файл просто окажется короче, как при ifstream.
+class MappedFile {
+public:
+    enum class Mode {
+        Map,    // без копирования; файл не должен меняться, пока открыт
+        Read    // копия в буфере; изменения файла после чтения не видны
+    };
+
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Открытие файла; пустой файл открывается успешно
+    bool open(const std::string& filename, Mode mode = Mode::Map);
+    void close();
+
+    bool isOpen() const { return open_; }
+    bool isMapped() const { return mapped_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+private:
+    bool map(int fd);
+    bool read(int fd);
+
+    const char* data_;
+    size_t size_;
+    bool open_;
+    bool mapped_;
+    std::unique_ptr<char[]> buffer_;
+};
+
+#endif // MAPPED_FILE_HPP
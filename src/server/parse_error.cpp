@@ -0,0 +1,143 @@
+/*
+ * Структурированные ошибки разбора файлов студентов
+ * Ошибки хранятся компактно и ограниченно, текст строится только при выводе
+ */
+
+#include "parse_error.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Обрезка по границе символа UTF-8: продолжающие байты имеют вид 10xxxxxx
+size_t utf8Prefix(std::string_view text, size_t limit) {
+    if (text.size() <= limit) {
+        return text.size();
+    }
+    size_t size = limit;
+    while (size > 0 && (static_cast<unsigned char>(text[size]) & 0xC0) == 0x80) {
+        size--;
+    }
+    return size;
+}
+
+} // namespace
+
+ParseError::ParseError()
+    : offset(0), fileIndex(0), line(0), column(0), length(0), kind(ParseErrorKind::FileOpen),
+      fieldSize(0) {
+}
+
+void ParseError::setField(std::string_view field) {
+    length = static_cast<uint16_t>(std::min<size_t>(field.size(), UINT16_MAX));
+    fieldSize = static_cast<uint8_t>(utf8Prefix(field, FIELD_TEXT_SIZE));
+    std::memcpy(fieldText, field.data(), fieldSize);
+}
+
+bool ParseError::operator==(const ParseError& other) const {
+    return offset == other.offset && fileIndex == other.fileIndex && line == other.line &&
+           column == other.column && length == other.length && kind == other.kind &&
+           field() == other.field();
+}
+
+ParseErrorLog::ParseErrorLog(size_t maxStored) : total_(0), maxStored_(maxStored) {
+    counts_.fill(0);
+}
+
+void ParseErrorLog::add(const ParseError& error) {
+    counts_[static_cast<size_t>(error.kind)]++;
+    total_++;
+    if (errors_.size() < maxStored_) {
+        errors_.push_back(error);
+    }
+}
+
+void ParseErrorLog::append(const ParseErrorLog& other) {
+    for (size_t i = 0; i < KIND_COUNT; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+
+    size_t room = maxStored_ - std::min(maxStored_, errors_.size());
+    size_t take = std::min(room, other.errors_.size());
+    errors_.insert(errors_.end(), other.errors_.begin(), other.errors_.begin() + take);
+}
+
+void ParseErrorLog::clear() {
+    errors_.clear();
+    counts_.fill(0);
+    total_ = 0;
+}
+
+void ParseErrorLog::setMaxStored(size_t maxStored) {
+    maxStored_ = maxStored;
+    if (errors_.size() > maxStored_) {
+        errors_.resize(maxStored_);
+    }
+}
+
+const char* ParseErrorLog::kindName(ParseErrorKind kind) {
+    switch (kind) {
+        case ParseErrorKind::FileOpen: return "файл не открыт";
+        case ParseErrorKind::FileRead: return "ошибка чтения файла";
+        case ParseErrorKind::MissingFields: return "недостаточно данных";
+        case ParseErrorKind::InvalidId: return "неверный формат ID";
+        case ParseErrorKind::NegativeId: return "отрицательный ID";
+        case ParseErrorKind::InvalidLastName: return "неверная фамилия";
+        case ParseErrorKind::InvalidFirstName: return "неверное имя";
+        case ParseErrorKind::InvalidBirthDate: return "неверная дата рождения";
+        default: return "неизвестная ошибка";
+    }
+}
+
+std::string ParseErrorLog::format(const ParseError& error, const std::string& filename) {
+    if (error.kind == ParseErrorKind::FileOpen) {
+        return "Ошибка: Не удалось открыть файл " + filename;
+    }
+    if (error.kind == ParseErrorKind::FileRead) {
+        return "Ошибка: Чтение файла " + filename + " прервано после " +
+               std::to_string(error.offset) + " байт";
+    }
+
+    // Поле сохранено при разборе; обрезанное помечается многоточием
+    std::string field(error.field());
+    if (error.fieldTruncated()) {
+        field += "...";
+    }
+
+    std::string message;
+    switch (error.kind) {
+        case ParseErrorKind::MissingFields:
+            message = "Недостаточно данных. Ожидается: ID Фамилия Имя [Отчество] ДатаРождения";
+            break;
+        case ParseErrorKind::InvalidId:
+            message = "Неверный формат ID: " + field;
+            break;
+        case ParseErrorKind::NegativeId:
+            message = "ID не может быть отрицательным: " + field;
+            break;
+        case ParseErrorKind::InvalidLastName:
+            message = "Неверная фамилия: '" + field + "'";
+            break;
+        case ParseErrorKind::InvalidFirstName:
+            message = "Неверное имя: '" + field + "'";
+            break;
+        case ParseErrorKind::InvalidBirthDate:
+            message = "Неверная дата рождения: '" + field + "'";
+            break;
+        default:
+            message = kindName(error.kind);
+            break;
+    }
+
+    return "Файл " + filename + ", строка " + std::to_string(error.line) + ": " + message;
+}
+
+std::vector<std::string> ParseErrorLog::format(const std::string& filename) const {
+    std::vector<std::string> messages;
+    messages.reserve(errors_.size());
+    for (const ParseError& error : errors_) {
+        messages.push_back(format(error, filename));
+    }
+    return messages;
+}
@@ -0,0 +1,93 @@
+#ifndef PARSE_ERROR_HPP
+#define PARSE_ERROR_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Виды ошибок разбора файла студентов
+enum class ParseErrorKind : uint8_t {
+    FileOpen,           // файл не удалось открыть
+    FileRead,           // чтение файла прервалось ошибкой; offset - сколько байт прочитано
+    MissingFields,      // в строке меньше четырёх полей
+    InvalidId,
+    NegativeId,
+    InvalidLastName,
+    InvalidFirstName,
+    InvalidBirthDate,
+    Count
+};
+
+// Компактная запись об ошибке. Сообщение строится по запросу из вида ошибки,
+// а начало ошибочного поля копируется при разборе: к моменту вывода
+// отслеживаемый файл мог измениться или укоротиться
+struct ParseError {
+    // Сколько байт ошибочного поля хранится в записи; длинное поле обрезается
+    static constexpr size_t FIELD_TEXT_SIZE = 32;
+
+    uint64_t offset;        // смещение начала строки в файле
+    uint32_t fileIndex;     // индекс файла в списке разбираемых файлов
+    uint32_t line;          // номер строки, 0 - ошибка всего файла
+    uint16_t column;        // смещение ошибочного поля в строке (не больше UINT16_MAX)
+    uint16_t length;        // длина ошибочного поля (не больше UINT16_MAX)
+    ParseErrorKind kind;
+    uint8_t fieldSize;      // байт поля в fieldText
+    char fieldText[FIELD_TEXT_SIZE];
+
+    ParseError();
+
+    // Копия начала поля; length - полная длина поля, насыщенная до UINT16_MAX,
+    // чтобы обрезка поля была видна при любом положении в строке
+    void setField(std::string_view field);
+    std::string_view field() const { return std::string_view(fieldText, fieldSize); }
+    bool fieldTruncated() const { return fieldSize < length; }
+
+    bool operator==(const ParseError& other) const;
+    bool operator!=(const ParseError& other) const { return !(*this == other); }
+};
+
+// Ошибки одного файла: первые maxStored записей и счётчики по всем видам.
+// Сверх лимита ошибки только подсчитываются
+class ParseErrorLog {
+public:
+    static constexpr size_t KIND_COUNT = static_cast<size_t>(ParseErrorKind::Count);
+    static constexpr size_t DEFAULT_MAX_STORED = 100;
+
+    explicit ParseErrorLog(size_t maxStored = DEFAULT_MAX_STORED);
+
+    void add(const ParseError& error);
+
+    // Ошибки следующего фрагмента того же файла (порядок сохраняется)
+    void append(const ParseErrorLog& other);
+
+    void clear();
+
+    void setMaxStored(size_t maxStored);
+    size_t maxStored() const { return maxStored_; }
+
+    const std::vector<ParseError>& stored() const { return errors_; }
+    size_t count(ParseErrorKind kind) const { return counts_[static_cast<size_t>(kind)]; }
+    size_t total() const { return total_; }
+    size_t dropped() const { return total_ - errors_.size(); }
+    bool empty() const { return total_ == 0; }
+
+    // Краткое название вида ошибки для сводки
+    static const char* kindName(ParseErrorKind kind);
+
+    // Текст ошибки в формате "Файл X, строка N: сообщение"; файл не читается
+    static std::string format(const ParseError& error, const std::string& filename);
+
+    // Тексты сохранённых ошибок
+    std::vector<std::string> format(const std::string& filename) const;
+
+private:
+    std::vector<ParseError> errors_;
+    std::array<size_t, KIND_COUNT> counts_;
+    size_t total_;
+    size_t maxStored_;
+};
+
+#endif // PARSE_ERROR_HPP
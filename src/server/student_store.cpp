@@ -0,0 +1,264 @@
+/*
+ * Инкрементальное хранилище объединённого списка студентов
+ */
+
+#include "student_store.hpp"
+#include <algorithm>
+#include <iterator>
+
+bool StudentStore::KeyLess::operator()(const Key& a, const Key& b) const {
+    if (a.lastName != b.lastName) {
+        return a.lastName.view() < b.lastName.view();
+    }
+    if (a.firstName != b.firstName) {
+        return a.firstName.view() < b.firstName.view();
+    }
+    return a.birthDate.daysSinceEpoch() < b.birthDate.daysSinceEpoch();
+}
+
+bool StudentStore::sameKey(const Key& a, const Key& b) {
+    return a.lastName == b.lastName && a.firstName == b.firstName && a.birthDate == b.birthDate;
+}
+
+bool StudentStore::RowLess::operator()(const Row& a, const Row& b) const {
+    KeyLess less;
+    if (!sameKey(a.key, b.key)) {
+        return less(a.key, b.key);
+    }
+    return *a.source < *b.source;
+}
+
+StudentStore::SourceRows StudentStore::sortedRows(const StudentTable& students) {
+    NamePool& pool = NamePool::global();
+    SourceRows rows;
+    rows.reserve(students.size());
+    for (size_t row = 0; row < students.size(); ++row) {
+        Key key{pool.intern(students.lastName(row)), pool.intern(students.firstName(row)),
+                students.birthDate(row)};
+        rows.emplace_back(key, students.id(row));
+    }
+
+    // Устойчивая сортировка: из повторов внутри файла остаётся первая строка
+    KeyLess less;
+    std::stable_sort(rows.begin(), rows.end(), [&less](const auto& a, const auto& b) {
+        return less(a.first, b.first);
+    });
+    rows.erase(std::unique(rows.begin(), rows.end(), [&less](const auto& a, const auto& b) {
+                   return !less(a.first, b.first) && !less(b.first, a.first);
+               }),
+               rows.end());
+    return rows;
+}
+
+StudentStore::Change StudentStore::replaceSource(const std::string& source,
+                                                 const StudentTable& students) {
+    SourceRows rows = sortedRows(students);
+    auto it = sources_.try_emplace(source).first;
+    const SourceRows& old = it->second;
+
+    // Слияние двух отсортированных списков: в индекс попадают только различия
+    SourceRows removed;
+    SourceRows added;
+    SourceRows updated;
+    KeyLess less;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < old.size() || j < rows.size()) {
+        if (j == rows.size() || (i < old.size() && less(old[i].first, rows[j].first))) {
+            removed.push_back(old[i++]);
+        } else if (i == old.size() || less(rows[j].first, old[i].first)) {
+            added.push_back(rows[j++]);
+        } else {
+            if (old[i].second != rows[j].second) {
+                updated.push_back(rows[j]);
+            }
+            i++;
+            j++;
+        }
+    }
+
+    applyChanges(&it->first, removed, added, updated);
+    it->second = std::move(rows);
+
+    Change change;
+    change.added = added.size();
+    change.removed = removed.size();
+    change.updated = updated.size();
+    return change;
+}
+
+StudentStore::Change StudentStore::removeSource(const std::string& source) {
+    Change change;
+    auto it = sources_.find(source);
+    if (it == sources_.end()) {
+        return change;
+    }
+    applyChanges(&it->first, it->second, SourceRows(), SourceRows());
+    change.removed = it->second.size();
+    sources_.erase(it);
+    return change;
+}
+
+void StudentStore::applyChanges(const std::string* source, const SourceRows& removed,
+                                const SourceRows& added, const SourceRows& updated) {
+    // Ключи изменений одного источника различны: размер меняется на разницу
+    // числа видимых записей с этими ключами до и после
+    size_t visibleBefore = 0;
+    for (const SourceRows* rows : {&removed, &added, &updated}) {
+        for (const auto& row : *rows) {
+            visibleBefore += touch(row.first) ? 1 : 0;
+        }
+    }
+
+    // Удаления и новые ID одним списком по ключу (nullopt - удаление):
+    // строки источника встречаются в индексе в том же порядке
+    KeyLess less;
+    std::vector<std::pair<Key, std::optional<int32_t>>> edits;
+    edits.reserve(removed.size() + updated.size());
+    size_t r = 0;
+    size_t u = 0;
+    while (r < removed.size() || u < updated.size()) {
+        if (u == updated.size() || (r < removed.size() && less(removed[r].first, updated[u].first))) {
+            edits.emplace_back(removed[r++].first, std::nullopt);
+        } else {
+            edits.emplace_back(updated[u].first, updated[u].second);
+            u++;
+        }
+    }
+
+    // Проход вперёд от первой правки: новые ID и сдвиг строк на место удалённых
+    if (!edits.empty()) {
+        size_t write = findRow(edits.front().first, source) - rows_.begin();
+        size_t e = 0;
+        for (size_t read = write; read < rows_.size(); ++read) {
+            Row& row = rows_[read];
+            if (e < edits.size() && row.source == source && sameKey(row.key, edits[e].first)) {
+                if (!edits[e++].second) {
+                    continue;
+                }
+                row.id = *edits[e - 1].second;
+            }
+            if (e == edits.size() && write == read) {
+                write = rows_.size();
+                break;
+            }
+            rows_[write++] = row;
+        }
+        rows_.resize(write);
+    }
+
+    // Слияние с конца: сдвигаются только строки после первой вставки
+    if (!added.empty()) {
+        RowLess rowLess;
+        size_t read = rows_.size();
+        rows_.resize(rows_.size() + added.size());
+        size_t write = rows_.size();
+        size_t a = added.size();
+        while (a > 0) {
+            Row inserted{added[a - 1].first, source, added[a - 1].second};
+            if (read > 0 && rowLess(inserted, rows_[read - 1])) {
+                rows_[--write] = rows_[--read];
+            } else {
+                rows_[--write] = inserted;
+                a--;
+            }
+        }
+    }
+
+    size_t visibleAfter = 0;
+    for (const SourceRows* rows : {&removed, &added, &updated}) {
+        for (const auto& row : *rows) {
+            visibleAfter += visibleId(row.first) ? 1 : 0;
+        }
+    }
+    size_ = size_ + visibleAfter - visibleBefore;
+}
+
+bool StudentStore::touch(const Key& key) {
+    pending_.emplace_back(key, visibleId(key));
+    return pending_.back().second.has_value();
+}
+
+std::vector<StudentStore::Row>::const_iterator StudentStore::findGroup(const Key& key) const {
+    return std::lower_bound(rows_.begin(), rows_.end(), key,
+                            [](const Row& row, const Key& k) { return KeyLess()(row.key, k); });
+}
+
+std::vector<StudentStore::Row>::iterator StudentStore::findRow(const Key& key,
+                                                               const std::string* source) {
+    auto it = std::lower_bound(rows_.begin(), rows_.end(), Row{key, source, 0}, RowLess());
+    if (it != rows_.end() && sameKey(it->key, key) && it->source == source) {
+        return it;
+    }
+    return rows_.end();
+}
+
+std::optional<int32_t> StudentStore::visibleId(const Key& key) const {
+    auto it = findGroup(key);
+    if (it != rows_.end() && sameKey(it->key, key)) {
+        return it->id;
+    }
+    return std::nullopt;
+}
+
+void StudentStore::appendRow(StudentTable& table, const Row& row) {
+    table.append(row.id, row.key.firstName.view(), row.key.lastName.view(), row.key.birthDate);
+}
+
+StudentTable StudentStore::table() const {
+    StudentTable table;
+    table.reserve(size_);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        // Видимая строка записи - первая в группе
+        if (i == 0 || !sameKey(rows_[i - 1].key, rows_[i].key)) {
+            appendRow(table, rows_[i]);
+        }
+    }
+    return table;
+}
+
+std::map<std::string, StudentTable> StudentStore::tablesBySource() const {
+    std::map<std::string, StudentTable> tables;
+    for (const auto& source : sources_) {
+        tables[source.first];
+    }
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (i == 0 || !sameKey(rows_[i - 1].key, rows_[i].key)) {
+            appendRow(tables[*rows_[i].source], rows_[i]);
+        }
+    }
+    return tables;
+}
+
+StudentDelta StudentStore::takeDelta() {
+    // Устойчивая сортировка: первым в группе ключа остаётся значение до всех изменений
+    KeyLess less;
+    std::stable_sort(pending_.begin(), pending_.end(), [&less](const auto& a, const auto& b) {
+        return less(a.first, b.first);
+    });
+    pending_.erase(std::unique(pending_.begin(), pending_.end(),
+                               [](const auto& a, const auto& b) { return sameKey(a.first, b.first); }),
+                   pending_.end());
+
+    StudentDelta delta;
+    for (const auto& entry : pending_) {
+        const Key& key = entry.first;
+        const std::optional<int32_t>& before = entry.second;
+        std::optional<int32_t> after = visibleId(key);
+        if (before == after) {
+            continue;
+        }
+        Student student(after ? *after : *before, key.firstName.view(), key.lastName.view(),
+                        key.birthDate);
+        if (!before) {
+            delta.added.push_back(student);
+        } else if (!after) {
+            delta.removed.push_back(student);
+        } else {
+            delta.modified.push_back(student);
+        }
+    }
+    // После первой загрузки список велик - память освобождается
+    decltype(pending_)().swap(pending_);
+    return delta;
+}
@@ -0,0 +1,116 @@
+#ifndef STUDENT_STORE_HPP
+#define STUDENT_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../common/name_pool.hpp"
+#include "../common/date.hpp"
+#include "../common/student_table.hpp"
+#include "../common/student_delta.hpp"
+
+// Долгоживущее хранилище объединённого списка, упорядоченное по личности
+// студента (фамилия, имя, дата рождения).
+//
+// Каждый файл-источник вносит свои записи; запись с одной личностью из
+// нескольких источников хранится один раз, видимым считается ID из первого
+// по имени источника (как при удалении дубликатов из списка всех файлов).
+// Замена источника сравнивает его старые и новые записи и меняет в индексе
+// только отличающиеся, без пересборки, хэширования и сортировки всего списка.
+//
+// Индекс - плоский вектор строк (запись, источник), отсортированный по личности
+// и имени источника: видимая строка записи - первая в своей группе. Строка
+// занимает 56 байт без отдельных выделений памяти (узел std::map с вектором
+// вкладов обходился примерно в 150 байт и два выделения на запись). Изменения
+// источника вносятся одним проходом на месте: сдвигается только часть вектора
+// после первой правки.
+//
+// Хранилище помнит видимые значения изменённых записей на момент прошлого
+// takeDelta, поэтому изменение списка для публикации строится за
+// O(изменённых записей · log n), без сравнения полных списков.
+class StudentStore {
+public:
+    // Итог изменения источника: записи, добавленные, удалённые и с новым ID
+    struct Change {
+        size_t added = 0;
+        size_t removed = 0;
+        size_t updated = 0;
+
+        size_t total() const { return added + removed + updated; }
+    };
+
+    // Записи источника заменяются новыми; повторы внутри файла учитываются один раз
+    Change replaceSource(const std::string& source, const StudentTable& students);
+    Change removeSource(const std::string& source);
+
+    bool hasSource(const std::string& source) const { return sources_.count(source) > 0; }
+    size_t sourceCount() const { return sources_.size(); }
+    // Уникальных записей
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Объединённый список без дубликатов, отсортированный по ФИО и дате рождения
+    StudentTable table() const;
+
+    // Тот же список по источникам: запись относится к источнику, чей ID видим.
+    // Каждый источник присутствует, даже если все его записи есть в предыдущих
+    std::map<std::string, StudentTable> tablesBySource() const;
+
+    // Изменение списка table() с прошлого вызова (с первого - от пустого списка):
+    // добавленные, удалённые и сменившие видимый ID записи. Версии не заполняются
+    StudentDelta takeDelta();
+
+private:
+    // Имена интернированы: ключ не владеет строками и сравнивается по адресу
+    struct Key {
+        InternedName lastName;
+        InternedName firstName;
+        Date birthDate;
+    };
+
+    struct KeyLess {
+        bool operator()(const Key& a, const Key& b) const;
+    };
+
+    static bool sameKey(const Key& a, const Key& b);
+
+    // Вклад источника в запись; указатель на ключ карты sources_ стабилен.
+    // Обычно у записи один вклад; несколько - если она повторяется в разных файлах
+    struct Row {
+        Key key;
+        const std::string* source;
+        int32_t id;
+    };
+
+    // Порядок индекса: личность, затем имя источника
+    struct RowLess {
+        bool operator()(const Row& a, const Row& b) const;
+    };
+
+    using SourceRows = std::vector<std::pair<Key, int32_t>>;
+
+    static SourceRows sortedRows(const StudentTable& students);
+    // Изменения одного источника; списки отсортированы по ключу
+    void applyChanges(const std::string* source, const SourceRows& removed,
+                      const SourceRows& added, const SourceRows& updated);
+    // Запоминает видимый ID записи перед её изменением; true - запись видима
+    bool touch(const Key& key);
+    std::vector<Row>::const_iterator findGroup(const Key& key) const;
+    std::vector<Row>::iterator findRow(const Key& key, const std::string* source);
+    std::optional<int32_t> visibleId(const Key& key) const;
+    static void appendRow(StudentTable& table, const Row& row);
+
+    std::vector<Row> rows_;
+    size_t size_ = 0;
+    // Записи каждого источника, отсортированные по ключу
+    std::map<std::string, SourceRows> sources_;
+    // Видимый ID изменённых записей до изменения (nullopt - записи не было);
+    // повторы ключа допустимы, takeDelta берёт самое раннее значение
+    std::vector<std::pair<Key, std::optional<int32_t>>> pending_;
+};
+
+#endif // STUDENT_STORE_HPP
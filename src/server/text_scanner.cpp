@@ -0,0 +1,365 @@
+/*
+ * Векторный сканер текста для парсера файлов студентов
+ * Строит битовые маски пробелов, переводов строк и комментариев блоками по 64 байта
+ */
+
+#include "text_scanner.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TEXT_SCANNER_X86 1
+#endif
+
+namespace {
+
+constexpr size_t BLOCK = 64;
+
+// Ядро для блока; у скалярной реализации ядра нет, она идёт по байтам
+struct Kernels {
+    TextScanner::Backend backend;
+    TextScanner::ClassifyFn classify;
+};
+
+#ifdef TEXT_SCANNER_X86
+
+__attribute__((target("sse2")))
+void classifySse2(const char* p, uint64_t& whitespace, uint64_t& newline, uint64_t& comment) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i hash = _mm_set1_epi8('#');
+    const __m128i semicolon = _mm_set1_epi8(';');
+    const __m128i four = _mm_set1_epi8(4);
+    whitespace = 0;
+    newline = 0;
+    comment = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        // c == ' ' или (c - '\t') <= 4 без знака
+        __m128i shifted = _mm_sub_epi8(v, tab);
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, four), shifted);
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(v, space), control);
+        __m128i marker = _mm_or_si128(_mm_cmpeq_epi8(v, hash), _mm_cmpeq_epi8(v, semicolon));
+        whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(ws))) << (16 * i);
+        newline |= static_cast<uint64_t>(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(v, lf)))) << (16 * i);
+        comment |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(marker))) << (16 * i);
+    }
+}
+
+__attribute__((target("avx2")))
+void classifyAvx2(const char* p, uint64_t& whitespace, uint64_t& newline, uint64_t& comment) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i hash = _mm256_set1_epi8('#');
+    const __m256i semicolon = _mm256_set1_epi8(';');
+    const __m256i four = _mm256_set1_epi8(4);
+    whitespace = 0;
+    newline = 0;
+    comment = 0;
+    for (int i = 0; i < 2; ++i) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * i));
+        __m256i shifted = _mm256_sub_epi8(v, tab);
+        __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, four), shifted);
+        __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(v, space), control);
+        __m256i marker = _mm256_or_si256(_mm256_cmpeq_epi8(v, hash), _mm256_cmpeq_epi8(v, semicolon));
+        whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(ws))) << (32 * i);
+        newline |= static_cast<uint64_t>(static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, lf)))) << (32 * i);
+        comment |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(marker))) << (32 * i);
+    }
+}
+
+#endif // TEXT_SCANNER_X86
+
+const Kernels SCALAR_KERNELS = {TextScanner::Backend::Scalar, nullptr};
+#ifdef TEXT_SCANNER_X86
+const Kernels SSE2_KERNELS = {TextScanner::Backend::Sse2, classifySse2};
+const Kernels AVX2_KERNELS = {TextScanner::Backend::Avx2, classifyAvx2};
+#endif
+
+const Kernels* detectKernels() {
+#ifdef TEXT_SCANNER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return &AVX2_KERNELS;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return &SSE2_KERNELS;
+    }
+#endif
+    return &SCALAR_KERNELS;
+}
+
+std::atomic<const Kernels*> g_kernels(detectKernels());
+
+const Kernels& kernels() {
+    return *g_kernels.load(std::memory_order_relaxed);
+}
+
+// Маски блока; неполный блок копируется в буфер, дополненный fill
+void classifyBlock(TextScanner::ClassifyFn classify, const char* p, size_t size, char fill,
+                   uint64_t& whitespace, uint64_t& newline, uint64_t& comment) {
+    if (size >= BLOCK) {
+        classify(p, whitespace, newline, comment);
+        return;
+    }
+    alignas(64) char buffer[BLOCK];
+    std::memset(buffer, fill, BLOCK);
+    std::memcpy(buffer, p, size);
+    classify(buffer, whitespace, newline, comment);
+}
+
+inline int lowestBit(uint64_t mask) {
+    return __builtin_ctzll(mask);
+}
+
+// События до первого перевода строки отбрасываются, сам перевод и всё после него остаются
+inline uint64_t skipToNewline(uint64_t events, uint64_t newlines) {
+    uint64_t pending = events & newlines;
+    if (pending == 0) {
+        return 0;
+    }
+    uint64_t first = pending & (~pending + 1);
+    return (events & ~((first << 1) - 1)) | first;
+}
+
+inline bool isCommentMarker(char c) {
+    return c == '#' || c == ';';
+}
+
+} // namespace
+
+TextScanner::Backend TextScanner::activeBackend() {
+    return kernels().backend;
+}
+
+const char* TextScanner::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Avx2: return "AVX2";
+        case Backend::Sse2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+bool TextScanner::isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar:
+            return true;
+#ifdef TEXT_SCANNER_X86
+        case Backend::Sse2:
+            return __builtin_cpu_supports("sse2");
+        case Backend::Avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+bool TextScanner::setBackend(Backend backend) {
+    if (!isSupported(backend)) {
+        return false;
+    }
+    switch (backend) {
+#ifdef TEXT_SCANNER_X86
+        case Backend::Avx2: g_kernels = &AVX2_KERNELS; break;
+        case Backend::Sse2: g_kernels = &SSE2_KERNELS; break;
+#endif
+        default: g_kernels = &SCALAR_KERNELS; break;
+    }
+    return true;
+}
+
+const char* TextScanner::findNewline(const char* begin, const char* end) {
+    ClassifyFn classify = kernels().classify;
+    if (!classify) {
+        const void* found = std::memchr(begin, '\n', end - begin);
+        return found ? static_cast<const char*>(found) : end;
+    }
+    uint64_t whitespace, newline, comment;
+    for (const char* p = begin; p < end; p += BLOCK) {
+        classifyBlock(classify, p, end - p, '\0', whitespace, newline, comment);
+        if (newline) {
+            return p + lowestBit(newline);
+        }
+    }
+    return end;
+}
+
+size_t TextScanner::countNewlines(const char* begin, const char* end) {
+    ClassifyFn classify = kernels().classify;
+    if (!classify) {
+        return std::count(begin, end, '\n');
+    }
+    uint64_t whitespace, newline, comment;
+    size_t count = 0;
+    for (const char* p = begin; p < end; p += BLOCK) {
+        classifyBlock(classify, p, end - p, '\0', whitespace, newline, comment);
+        count += __builtin_popcountll(newline);
+    }
+    return count;
+}
+
+const char* TextScanner::skipSpaces(const char* begin, const char* end) {
+    ClassifyFn classify = kernels().classify;
+    if (!classify) {
+        while (begin < end && isSpace(*begin)) {
+            ++begin;
+        }
+        return begin;
+    }
+    uint64_t whitespace, newline, comment;
+    for (const char* p = begin; p < end; p += BLOCK) {
+        // Хвост дополнен пробелами, поэтому за концом непробельных символов нет
+        classifyBlock(classify, p, end - p, ' ', whitespace, newline, comment);
+        if (~whitespace) {
+            return p + lowestBit(~whitespace);
+        }
+    }
+    return end;
+}
+
+std::string_view TextScanner::trim(std::string_view text) {
+    const char* begin = skipSpaces(text.data(), text.data() + text.size());
+    const char* end = text.data() + text.size();
+    // Пробелов в конце строки обычно мало - идём назад поштучно
+    while (end > begin && isSpace(end[-1])) {
+        --end;
+    }
+    return std::string_view(begin, end - begin);
+}
+
+TextScanner::LineTokenizer::LineTokenizer(std::string_view buffer)
+    : classify_(kernels().classify), data_(buffer.data()), size_(buffer.size()), blockBase_(0),
+      starts_(0), ends_(0), newlines_(0), comments_(0), events_(0), inToken_(0),
+      tokenStart_(0), lineStart_(0) {
+    if (classify_ && size_ > 0) {
+        loadBlock();
+    }
+}
+
+void TextScanner::LineTokenizer::loadBlock() {
+    uint64_t whitespace = 0;
+    uint64_t newline = 0;
+    uint64_t comment = 0;
+    // Последний неполный блок дополняется пробелами (но не '\n')
+    classifyBlock(classify_, data_ + blockBase_, size_ - blockBase_, ' ', whitespace, newline, comment);
+
+    uint64_t token = ~whitespace;
+    uint64_t previous = (token << 1) | inToken_;
+    starts_ = token & ~previous;
+    ends_ = ~token & previous;
+    newlines_ = newline;
+    comments_ = comment;
+    events_ = starts_ | ends_ | newlines_;
+    inToken_ = token >> 63;
+}
+
+bool TextScanner::LineTokenizer::next(Line& line) {
+    if (lineStart_ >= size_) {
+        return false;
+    }
+    if (!classify_) {
+        return nextScalar(line);
+    }
+
+    line.tokenCount = 0;
+    line.tail = std::string_view();
+    line.comment = false;
+
+    auto addToken = [&](size_t from, size_t to) {
+        std::string_view token(data_ + from, to - from);
+        if (line.tokenCount < Line::HEAD_SIZE) {
+            line.head[line.tokenCount] = token;
+        }
+        line.tail = token;
+        line.tokenCount++;
+    };
+    // Первый токен комментария уже прочитан
+    auto skipping = [&] { return line.comment && line.tokenCount > 0; };
+
+    while (true) {
+        while (events_ == 0) {
+            blockBase_ += BLOCK;
+            if (blockBase_ >= size_) {
+                // Последняя строка без завершающего '\n'
+                if (inToken_ && !skipping()) {
+                    addToken(tokenStart_, size_);
+                }
+                inToken_ = 0;
+                line.text = std::string_view(data_ + lineStart_, size_ - lineStart_);
+                lineStart_ = size_;
+                return true;
+            }
+            loadBlock();
+            if (skipping()) {
+                events_ = skipToNewline(events_, newlines_);
+            }
+        }
+
+        int bit = lowestBit(events_);
+        events_ &= events_ - 1;
+        size_t position = blockBase_ + bit;
+
+        if (!skipping()) {
+            if ((starts_ >> bit) & 1) {
+                tokenStart_ = position;
+                line.comment = line.tokenCount == 0 && ((comments_ >> bit) & 1);
+            }
+            if ((ends_ >> bit) & 1) {
+                addToken(tokenStart_, std::min(position, size_));
+                if (skipping()) {
+                    // Остаток комментария не разбирается: ждём только перевода строки
+                    events_ = skipToNewline(events_, newlines_);
+                }
+            }
+        }
+        if ((newlines_ >> bit) & 1) {
+            line.text = std::string_view(data_ + lineStart_, position - lineStart_);
+            lineStart_ = position + 1;
+            return true;
+        }
+    }
+}
+
+bool TextScanner::LineTokenizer::nextScalar(Line& line) {
+    const char* begin = data_ + lineStart_;
+    const char* end = data_ + size_;
+    const void* newline = std::memchr(begin, '\n', end - begin);
+    const char* lineEnd = newline ? static_cast<const char*>(newline) : end;
+    line.text = std::string_view(begin, lineEnd - begin);
+    lineStart_ = lineEnd - data_ + 1;
+
+    // Состояние в локальных переменных: запись в line через char-данные
+    // мешает компилятору держать его в регистрах
+    size_t count = 0;
+    const char* tailBegin = nullptr;
+    const char* tailEnd = nullptr;
+    bool comment = false;
+    const char* p = begin;
+    while (p < lineEnd) {
+        while (p < lineEnd && isSpace(*p)) ++p;
+        if (p == lineEnd) break;
+        tailBegin = p;
+        while (p < lineEnd && !isSpace(*p)) ++p;
+        tailEnd = p;
+
+        if (count < Line::HEAD_SIZE) {
+            line.head[count] = std::string_view(tailBegin, tailEnd - tailBegin);
+        }
+        if (count++ == 0 && isCommentMarker(*tailBegin)) {
+            comment = true;
+            break;
+        }
+    }
+    line.tokenCount = count;
+    line.tail = std::string_view(tailBegin, tailEnd - tailBegin);
+    line.comment = comment;
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef TEXT_SCANNER_HPP
+#define TEXT_SCANNER_HPP
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// Векторный поиск структурных символов во входных файлах.
+// Текст обрабатывается блоками по 64 байта: одно ядро (SSE2/AVX2) строит для
+// блока маски пробельных символов, переводов строк и маркеров комментариев,
+// а границы токенов извлекаются битовыми операциями. Без векторных инструкций
+// используется обычный побайтовый разбор.
+// Реализация выбирается один раз при запуске по возможностям процессора.
+class TextScanner {
+public:
+    enum class Backend { Scalar, Sse2, Avx2 };
+
+    // Маски 64-байтового блока: пробельные символы, '\n' и '#'/';'
+    using ClassifyFn = void (*)(const char* p, uint64_t& whitespace, uint64_t& newline, uint64_t& comment);
+
+    static Backend activeBackend();
+    static const char* backendName(Backend backend);
+
+    // Проверка поддержки и принудительный выбор реализации (для тестов и бенчмарков)
+    static bool isSupported(Backend backend);
+    static bool setBackend(Backend backend);
+
+    // Первый '\n' в [begin, end) или end
+    static const char* findNewline(const char* begin, const char* end);
+
+    // Количество '\n' в [begin, end)
+    static size_t countNewlines(const char* begin, const char* end);
+
+    // Первый непробельный символ в [begin, end) или end
+    static const char* skipSpaces(const char* begin, const char* end);
+
+    // Строка без пробельных символов по краям
+    static std::string_view trim(std::string_view text);
+
+    static bool isSpace(char c) {
+        return c == ' ' || (static_cast<unsigned char>(c) - 9u) <= 4u; // \t \n \v \f \r
+    }
+
+    // Строка буфера, разбитая на токены по пробельным символам
+    struct Line {
+        static constexpr size_t HEAD_SIZE = 3;
+
+        std::string_view text;                 // строка без '\n'
+        std::string_view head[HEAD_SIZE];      // первые токены строки
+        std::string_view tail;                 // последний токен строки
+        size_t tokenCount;
+        bool comment;                          // первый токен начинается с '#' или ';'
+    };
+
+    // Однопроходный разбор буфера на строки и токены.
+    // Каждый 64-байтовый блок классифицируется один раз, дальше границы токенов
+    // и строк берутся из масок. У строки-комментария разбирается только первый
+    // токен, остальное пропускается до перевода строки.
+    class LineTokenizer {
+    public:
+        explicit LineTokenizer(std::string_view buffer);
+
+        // Следующая строка; false, когда буфер закончился
+        bool next(Line& line);
+
+    private:
+        void loadBlock();
+        bool nextScalar(Line& line);
+
+    private:
+        ClassifyFn classify_;                  // nullptr - побайтовый разбор
+        const char* data_;
+        size_t size_;
+        size_t blockBase_;
+        uint64_t starts_;
+        uint64_t ends_;
+        uint64_t newlines_;
+        uint64_t comments_;
+        uint64_t events_;
+        uint64_t inToken_;
+        size_t tokenStart_;
+        size_t lineStart_;
+    };
+};
+
+#endif // TEXT_SCANNER_HPP
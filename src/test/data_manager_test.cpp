@@ -1,7 +1,13 @@
 #include <iostream>
 #include <vector>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <algorithm>
 #include "../server/data_manager.hpp"
 #include "../common/student.hpp"
+#include "../common/student_table.hpp"
+#include "../common/student_delta.hpp"
 
 // Создаем тестовые данные
 std::vector<Student> createTestList1() {
@@ -67,9 +73,298 @@ void testDataManager() {
     for (const auto& student : sortedList) {
         student.print();
     }
+    
+    // Тест 7: Тот же конвейер над колоночной таблицей
+    std::cout << "\n7. ОБРАБОТКА КОЛОНОЧНОЙ ТАБЛИЦЫ:" << std::endl;
+    StudentTable table(createTestList1());
+    for (const auto& student : createTestList2()) {
+        table.append(student);
+    }
+    StudentTable processed = manager.sortStudentsByName(
+        manager.removeDuplicates(manager.filterValidStudents(table)));
+    std::cout << "Было: " << table.size() << " строк" << std::endl;
+    std::cout << "Стало: " << processed.size() << " строк" << std::endl;
+    for (size_t row = 0; row < processed.size(); ++row) {
+        processed.student(row).print();
+    }
+}
+
+void testStudentStore() {
+    std::cout << "\n=== ТЕСТИРОВАНИЕ ИНКРЕМЕНТАЛЬНОГО ХРАНИЛИЩА ===" << std::endl;
+    
+    DataManager manager;
+    StudentStore& store = manager.store();
+    
+    // Изменение из takeDelta, применённое к прошлому списку, даёт текущий
+    std::vector<Student> published;
+    auto checkDelta = [&store, &published]() {
+        StudentDelta delta = store.takeDelta();
+        delta.apply(published);
+        std::vector<Student> current = store.table().toStudents();
+        assert(published.size() == current.size());
+        for (size_t i = 0; i < current.size(); ++i) {
+            assert(published[i] == current[i] && published[i].getId() == current[i].getId());
+        }
+        return delta;
+    };
+    
+    // Тот же результат, что удаление дубликатов и сортировка списка всех файлов
+    store.replaceSource("a.txt", StudentTable(createTestList1()));
+    store.replaceSource("b.txt", StudentTable(createTestList2()));
+    store.replaceSource("c.txt", StudentTable(createTestList3()));
+    std::vector<Student> all = createTestList1();
+    for (const auto& list : {createTestList2(), createTestList3()}) {
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    std::vector<Student> expected = manager.sortStudentsByName(manager.removeDuplicates(all));
+    std::vector<Student> stored = store.table().toStudents();
+    assert(stored.size() == expected.size());
+    for (size_t i = 0; i < stored.size(); ++i) {
+        assert(stored[i] == expected[i] && stored[i].getId() == expected[i].getId());
+    }
+    assert(checkDelta().added.size() == expected.size());
+    
+    // Замена файла: меняются только отличающиеся записи; ID берётся из первого файла
+    std::vector<Student> edited = createTestList1();
+    edited.pop_back();                                           // удалена Popova
+    edited[0].setId(100);                                        // новый ID у Ivanov
+    edited.push_back(Student(12, "Boris", "Borisov", "01.02.1993"));
+    StudentStore::Change change = store.replaceSource("a.txt", StudentTable(edited));
+    std::cout << "Изменения файла: +" << change.added << " -" << change.removed
+              << " ~" << change.updated << std::endl;
+    assert(change.added == 1 && change.removed == 1 && change.updated == 1);
+    StudentTable table = store.table();
+    assert(table.size() == expected.size());
+    assert(table.lastName(0) == "Alexeev" && table.lastName(1) == "Borisov");
+    StudentDelta delta = checkDelta();
+    assert(delta.added.size() == 1 && delta.removed.size() == 1 && delta.modified.size() == 1);
+    
+    // Повторная замена тем же содержимым изменений не даёт
+    store.replaceSource("a.txt", StudentTable(edited));
+    assert(checkDelta().empty());
+    
+    // Удалённый файл: его записи остаются, только если есть в других файлах
+    store.removeSource("a.txt");
+    table = store.table();
+    for (size_t row = 0; row < table.size(); ++row) {
+        if (table.lastName(row) == "Ivanov") {
+            assert(table.id(row) == 7);
+        }
+        assert(table.lastName(row) != "Borisov" && table.lastName(row) != "Sidorova");
+    }
+    std::map<std::string, StudentTable> bySource = store.tablesBySource();
+    assert(bySource.size() == 2 && bySource["c.txt"].size() == 2);
+    // ID повторяющейся записи переходит к следующему файлу
+    delta = checkDelta();
+    assert(!delta.modified.empty() && !delta.removed.empty());
+    
+    // Правка одного файла в большом списке против полной пересборки
+    const int FILES = 8;
+    const int ROWS = 50000;
+    std::vector<StudentTable> files(FILES);
+    for (int f = 0; f < FILES; ++f) {
+        for (int i = 0; i < ROWS; ++i) {
+            int n = f * ROWS + i;
+            files[f].append(n, "Имя" + std::to_string(n % 997), "Фамилия" + std::to_string(n / 7),
+                            Date::fromDays(5000 + n % 9000));
+        }
+        store.replaceSource("big" + std::to_string(f) + ".txt", files[f]);
+    }
+    checkDelta();
+    for (int i = 0; i < 10; ++i) {
+        files[3].append(900000 + i, "Новый", "Студент" + std::to_string(i), Date::fromDays(7000));
+    }
+    
+    auto started = std::chrono::steady_clock::now();
+    change = store.replaceSource("big3.txt", files[3]);
+    delta = store.takeDelta();
+    auto incremental = std::chrono::steady_clock::now() - started;
+    delta.apply(published);
+    
+    started = std::chrono::steady_clock::now();
+    StudentTable rebuilt;
+    for (const StudentTable& file : files) {
+        rebuilt.appendTable(file);
+    }
+    rebuilt = manager.sortStudentsByName(manager.removeDuplicates(rebuilt));
+    auto full = std::chrono::steady_clock::now() - started;
+    
+    assert(change.added == 10 && change.removed == 0 && delta.added.size() == 10);
+    assert(store.table().size() == rebuilt.size() + bySource["b.txt"].size() + 2);
+    assert(published.size() == store.size());
+    std::cout << "Правка файла из " << files[3].size() << " строк в списке из " << store.size()
+              << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(incremental).count()
+              << " мс, полная пересборка: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(full).count() << " мс" << std::endl;
+    
+    // Удалены все файлы: хранилище пустое, тем по файлам не остаётся
+    for (const auto& source : store.tablesBySource()) {
+        store.removeSource(source.first);
+    }
+    checkDelta();
+    assert(published.empty());
+    assert(store.size() == 0 && store.table().empty() && store.tablesBySource().empty());
+    std::cout << "Инкрементальное хранилище работает корректно!" << std::endl;
+}
+
+void testDuplicateReport() {
+    std::cout << "\n=== ТЕСТИРОВАНИЕ ОТЧЁТА О ДУБЛИКАТАХ ===" << std::endl;
+    
+    DataManager manager;
+    DataManager::MergeResult result =
+        manager.mergeMultipleLists({createTestList1(), createTestList2(), createTestList3()});
+    
+    // Группы в порядке личности: Ivanov (4 записи), затем Petrov (2)
+    assert(result.totalStudents == 13 && result.duplicatesRemoved == 4);
+    assert(result.mergedStudents.size() == 9);
+    assert(result.duplicateGroups.size() == 2);
+    assert(result.duplicateGroups[0].student.getLastName() == "Ivanov");
+    assert(result.duplicateGroups[0].count == 4);
+    assert(result.duplicateGroups[0].records[2].getId() == 7);
+    assert(result.duplicateGroups[1].student.getLastName() == "Petrov");
+    assert(result.duplicateGroups[1].count == 2);
+    assert(result.duplicates.size() == 6);
+    assert(std::is_sorted(result.mergedStudents.begin(), result.mergedStudents.end()));
+    for (const auto& group : result.duplicateGroups) {
+        std::cout << group.student.getLastName() << " " << group.student.getFirstName()
+                  << ": " << group.count << " записей" << std::endl;
+    }
+    
+    DataManager::MergeResult counts = manager.mergeStudents(
+        createTestList1(), createTestList2(), DataManager::DuplicateReport::Counts);
+    assert(counts.duplicateGroups.size() == 2 && counts.duplicateGroups[0].count == 3);
+    assert(counts.duplicateGroups[0].records.empty() && counts.duplicates.empty());
+    
+    // Большой список: один проход по хэш-таблице вместо попарного сравнения
+    const int LISTS = 4;
+    const int ROWS = 500000;
+    std::vector<std::vector<Student>> lists(LISTS);
+    for (int l = 0; l < LISTS; ++l) {
+        lists[l].reserve(ROWS);
+        for (int i = 0; i < ROWS; ++i) {
+            // Каждая десятая запись повторяет запись первого списка
+            int n = (i % 10 == 0) ? i : l * ROWS + i;
+            lists[l].emplace_back(n, "Имя" + std::to_string(n % 1000), "Фамилия" + std::to_string(n / 1000),
+                                  Date::fromDays(n % 20000));
+        }
+    }
+    auto started = std::chrono::steady_clock::now();
+    DataManager::MergeResult large = manager.mergeMultipleLists(lists, DataManager::DuplicateReport::Counts);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    
+    assert(large.duplicateGroups.size() == static_cast<size_t>(ROWS / 10));
+    assert(large.duplicateGroups[1].count == static_cast<size_t>(LISTS));
+    assert(large.duplicatesRemoved == (LISTS - 1) * ROWS / 10);
+    std::cout << "Объединено " << large.totalStudents << " записей, групп дубликатов: "
+              << large.duplicateGroups.size() << ", "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " мс" << std::endl;
+    std::cout << "Отчёт о дубликатах работает корректно!" << std::endl;
+}
+
+void testSortedMerge() {
+    std::cout << "\n=== ТЕСТИРОВАНИЕ СЛИЯНИЯ ОТСОРТИРОВАННЫХ СПИСКОВ ===" << std::endl;
+    
+    // Устойчивая сортировка: из повторов внутри файла первым остаётся прежний
+    std::vector<std::vector<Student>> lists = {createTestList1(), createTestList2(), createTestList3()};
+    for (auto& list : lists) {
+        std::stable_sort(list.begin(), list.end());
+        assert(DataManager::isSortedByName(list));
+    }
+    assert(!DataManager::isSortedByName(createTestList2()));
+    
+    DataManager manager;
+    DataManager::MergeResult hashed = manager.mergeMultipleLists(
+        {createTestList1(), createTestList2(), createTestList3()});
+    DataManager::MergeResult merged = manager.mergeSortedLists(lists);
+    assert(merged.totalStudents == hashed.totalStudents);
+    assert(merged.duplicatesRemoved == hashed.duplicatesRemoved);
+    assert(merged.mergedStudents.size() == hashed.mergedStudents.size());
+    for (size_t i = 0; i < merged.mergedStudents.size(); ++i) {
+        assert(merged.mergedStudents[i] == hashed.mergedStudents[i]);
+        assert(merged.mergedStudents[i].getId() == hashed.mergedStudents[i].getId());
+    }
+    // Группы в порядке ФИО: Ivanov раньше Petrov, записи - в порядке списков
+    assert(merged.duplicateGroups.size() == hashed.duplicateGroups.size());
+    for (size_t i = 0; i < merged.duplicateGroups.size(); ++i) {
+        assert(merged.duplicateGroups[i].student == hashed.duplicateGroups[i].student);
+        assert(merged.duplicateGroups[i].count == hashed.duplicateGroups[i].count);
+    }
+    assert(merged.duplicates.size() == hashed.duplicates.size());
+    for (size_t i = 0; i < merged.duplicates.size(); ++i) {
+        assert(merged.duplicates[i] == hashed.duplicates[i]);
+    }
+    assert(merged.duplicateGroups.size() == 2);
+    assert(merged.duplicateGroups[0].student.getLastName() == "Ivanov");
+    assert(merged.duplicateGroups[0].count == 4);
+    assert(merged.duplicateGroups[0].records[2].getId() == 7);
+    assert(merged.duplicateGroups[1].count == 2 && merged.duplicates.size() == 6);
+    
+    // mergeMultipleLists сам выбирает слияние для отсортированных списков
+    DataManager::MergeResult detected = manager.mergeMultipleLists(lists, DataManager::DuplicateReport::Counts);
+    assert(detected.mergedStudents.size() == merged.mergedStudents.size());
+    assert(detected.duplicateGroups.size() == 2 && detected.duplicateGroups[0].records.empty());
+    
+    // Тёзки с разными датами: повтор не соседствует с оригиналом в потоке, первым
+    // приходит повтор второй даты. Группы всё равно по дате, как у хэш-таблицы
+    std::vector<std::vector<Student>> namesakes = {
+        {Student(1, "Ivan", "Ivanov", "01.01.1990"), Student(2, "Ivan", "Ivanov", "02.02.1991")},
+        {Student(3, "Ivan", "Ivanov", "02.02.1991"), Student(4, "Ivan", "Ivanov", "01.01.1990")}};
+    DataManager::MergeResult same = manager.mergeSortedLists(namesakes);
+    DataManager::MergeResult sameHashed = manager.mergeStudents(namesakes[0], namesakes[1]);
+    assert(same.mergedStudents.size() == 2 && same.duplicatesRemoved == 2);
+    assert(same.mergedStudents[0].getId() == 1 && same.mergedStudents[1].getId() == 2);
+    assert(same.duplicateGroups.size() == 2 && sameHashed.duplicateGroups.size() == 2);
+    assert(same.duplicateGroups[0].student.getId() == 1 && same.duplicateGroups[0].records[1].getId() == 4);
+    assert(same.duplicateGroups[1].student.getId() == 2 && same.duplicateGroups[1].records[1].getId() == 3);
+    for (size_t i = 0; i < same.duplicates.size(); ++i) {
+        assert(same.duplicates[i].getId() == sameHashed.duplicates[i].getId());
+    }
+    
+    // Много тёзок с разными датами: повтор ищется по дате, а не перебором ряда
+    const int NAMESAKES = 50000;
+    std::vector<std::vector<Student>> cohort(2);
+    for (int i = 0; i < NAMESAKES; ++i) {
+        cohort[0].emplace_back(i, "Ivan", "Ivanov", Date::fromDays(i));
+        cohort[1].emplace_back(NAMESAKES + i, "Ivan", "Ivanov", Date::fromDays(NAMESAKES - 1 - i));
+    }
+    auto cohortStarted = std::chrono::steady_clock::now();
+    DataManager::MergeResult namesakeMerge =
+        manager.mergeSortedLists(cohort, DataManager::DuplicateReport::Counts);
+    auto cohortElapsed = std::chrono::steady_clock::now() - cohortStarted;
+    assert(namesakeMerge.mergedStudents.size() == static_cast<size_t>(NAMESAKES));
+    assert(namesakeMerge.duplicateGroups.size() == static_cast<size_t>(NAMESAKES));
+    assert(namesakeMerge.duplicateGroups[0].student.getId() == 0 && namesakeMerge.duplicateGroups[0].count == 2);
+    std::cout << "Тёзок " << NAMESAKES << " в двух списках: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(cohortElapsed).count() << " мс" << std::endl;
+    
+    // Большие отсортированные списки: O(n log k) без общей сортировки
+    const int LISTS = 8;
+    const int ROWS = 250000;
+    std::vector<std::vector<Student>> large(LISTS);
+    for (int l = 0; l < LISTS; ++l) {
+        large[l].reserve(ROWS);
+        for (int i = 0; i < ROWS; ++i) {
+            // Каждая пятая запись общая для всех списков
+            int n = (i % 5 == 0) ? i : l * ROWS + i;
+            large[l].emplace_back(n, "Имя" + std::to_string(n % 1000), "Фамилия" + std::to_string(n / 1000),
+                                  Date::fromDays(n % 20000));
+        }
+        std::stable_sort(large[l].begin(), large[l].end());
+    }
+    auto started = std::chrono::steady_clock::now();
+    size_t unique = manager.mergeSortedLists(large, DataManager::DuplicateReport::None).mergedStudents.size();
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    assert(unique == static_cast<size_t>(LISTS * ROWS - (LISTS - 1) * ROWS / 5));
+    std::cout << "Слито " << LISTS * ROWS << " записей из " << LISTS << " списков, уникальных: " << unique
+              << ", " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " мс"
+              << std::endl;
+    std::cout << "Слияние отсортированных списков работает корректно!" << std::endl;
 }
 
 int main() {
     testDataManager();
+    testDuplicateReport();
+    testSortedMerge();
+    testStudentStore();
     return 0;
 }
\ No newline at end of file
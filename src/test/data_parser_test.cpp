@@ -1,6 +1,11 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
 #include "../server/data_parser.hpp"
+#include "../server/text_scanner.hpp"
 #include "../common/student.hpp"
 
 void createTestFiles() {
@@ -42,6 +47,30 @@ void testDataParser() {
         student.print();
     }
     
+    // Строка длиннее пяти полей: отчество - всё между именем и последним полем,
+    // дата - последнее поле (раньше дата бралась из пятого поля и строка отвергалась)
+    assert(result1.students.size() == 5);
+    const Student& longLine = result1.students[4];
+    assert(longLine.getId() == 6 && longLine.getLastName() == "Test" && longLine.getFirstName() == "User");
+    assert(longLine.getBirthDate() == "15.03.1990");
+    // Дата хранится значением и выводится в обычном виде: 04.5.1987 -> 04.05.1987
+    assert(result1.students[2].getId() == 4 && result1.students[2].getBirthDate() == "04.05.1987");
+    
+    // Отображение и чтение в буфер дают одинаковый результат
+    DataParser mappedParser;
+    mappedParser.setFileMode(MappedFile::Mode::Map);
+    assert(mappedParser.parseStudentFile("student_file_1.txt").students == result1.students);
+    
+    // Прочитанный в буфер файл не зависит от файла на диске: укорачивание после
+    // открытия не меняет данные (у отображения это SIGBUS при чтении)
+    {
+        std::ofstream("student_file_truncated.txt") << "1 Ivan Ivanov 01.01.1990\n";
+        MappedFile copy;
+        assert(copy.open("student_file_truncated.txt", MappedFile::Mode::Read) && !copy.isMapped());
+        std::ofstream("student_file_truncated.txt", std::ios::trunc).close();
+        assert(copy.view() == "1 Ivan Ivanov 01.01.1990\n");
+    }
+    
     // Тест 2: Парсинг нескольких файлов
     std::cout << "\n2. Парсинг нескольких файлов:" << std::endl;
     std::vector<std::string> filenames = {"../database/student_file_1.txt", "../database/student_file_2.txt"};
@@ -54,9 +83,240 @@ void testDataParser() {
     for (size_t i = 0; i < std::min(allStudents.size(), size_t(5)); ++i) {
         allStudents[i].print();
     }
+    
+    // Тест 4: Комментарии, CRLF, лишние пробелы и пустой файл
+    std::cout << "\n4. Граничные случаи формата файла:" << std::endl;
+    std::ofstream edge("student_file_edge.txt", std::ios::binary);
+    edge << "# комментарий\r\n";
+    edge << "; ещё комментарий\r\n";
+    edge << "\r\n";
+    edge << "  7   Anna\tSidorova   20.03.1992  \r\n";
+    edge << "8 Oleg Olegov 01.01.1990"; // без перевода строки в конце
+    edge.close();
+    std::ofstream("student_file_empty.txt").close();
+    
+    auto edgeResult = parser.parseStudentFile("student_file_edge.txt");
+    std::cout << "Строк: " << edgeResult.totalLines << ", валидных: " << edgeResult.validLines 
+              << ", ошибок: " << edgeResult.errors.total() << std::endl;
+    for (const auto& student : edgeResult.students) {
+        student.print();
+    }
+    auto emptyResult = parser.parseStudentFile("student_file_empty.txt");
+    std::cout << "Пустой файл: строк " << emptyResult.totalLines 
+              << ", ошибок " << emptyResult.errors.total() << std::endl;
+    
+    // Тест 5: Параллельный разбор нескольких файлов
+    std::cout << "\n5. Параллельный разбор файлов:" << std::endl;
+    std::vector<std::string> manyFiles;
+    for (int i = 0; i < 8; ++i) {
+        manyFiles.push_back(i % 2 == 0 ? "student_file_1.txt" : "student_file_2.txt");
+    }
+    DataParser parallelParser(4);
+    auto sequential = parser.parseStudentFiles(manyFiles);
+    auto parallel = parallelParser.parseStudentFiles(manyFiles);
+    bool sameOrder = sequential.size() == parallel.size();
+    for (size_t i = 0; sameOrder && i < sequential.size(); ++i) {
+        sameOrder = sequential[i].students == parallel[i].students &&
+                    sequential[i].errors.stored() == parallel[i].errors.stored();
+    }
+    std::cout << "Потоков: " << parallelParser.getWorkerCount() 
+              << ", результаты совпадают с последовательным разбором: " << sameOrder << std::endl;
+    
+    StudentTable table = parallelParser.parseMultipleFilesToTable(manyFiles);
+    std::cout << "Строк в таблице: " << table.size() << std::endl;
+    
+    // Тест 6: Разбор одного файла по фрагментам
+    std::cout << "\n6. Разбор одного файла по фрагментам:" << std::endl;
+    DataParser chunkedParser(4);
+    chunkedParser.setChunkSize(32); // несколько строк на фрагмент
+    auto whole = parser.parseStudentFile("student_file_2.txt");
+    auto chunked = chunkedParser.parseStudentFile("student_file_2.txt");
+    std::cout << "Строк: " << chunked.totalLines << ", записи и ошибки совпадают: "
+              << (whole.students == chunked.students && whole.errors.stored() == chunked.errors.stored()) << std::endl;
+    for (const auto& error : chunked.errors.format("student_file_2.txt")) {
+        std::cout << "  " << error << std::endl;
+    }
+    
+    // Тест 7: Потоковый разбор порциями
+    std::cout << "\n7. Потоковый разбор порциями:" << std::endl;
+    DataParser streamingParser;
+    streamingParser.setBatchSize(2);
+    std::vector<std::string> streamFiles = {"student_file_1.txt", "student_file_2.txt", "missing_file.txt"};
+    std::vector<Student> streamed;
+    std::vector<ParseError> streamedErrors;
+    size_t batches = 0;
+    size_t largestBatch = 0;
+    auto stats = streamingParser.parseStudentFilesStreaming(streamFiles, [&](DataParser::ParseBatch& batch) {
+        batches++;
+        largestBatch = std::max(largestBatch, batch.students.size());
+        for (const Student& student : batch.students.toStudents()) {
+            streamed.push_back(student);
+        }
+        streamedErrors.insert(streamedErrors.end(), batch.errors.begin(), batch.errors.end());
+    });
+    auto expected = parser.parseStudentFiles(streamFiles);
+    std::vector<Student> expectedStudents;
+    size_t expectedErrors = 0;
+    for (const auto& result : expected) {
+        expectedStudents.insert(expectedStudents.end(), result.students.begin(), result.students.end());
+        expectedErrors += result.errors.total();
+    }
+    std::cout << "Порций: " << batches << ", максимум записей в порции: " << largestBatch << std::endl;
+    std::cout << "Записи совпадают с полным разбором: " << (streamed == expectedStudents)
+              << ", ошибок: " << streamedErrors.size() << " из " << expectedErrors << std::endl;
+    std::cout << "Строк в первом файле: " << stats[0].totalLines
+              << ", записей в статистике нет: " << stats[0].students.empty() << std::endl;
+    
+    // Файлы читаются фрагментами по chunkSize байт; строка длиннее фрагмента
+    // дочитывается целиком, номера строк и смещения ошибок не сдвигаются
+    DataParser smallReadParser;
+    smallReadParser.setChunkSize(20);
+    std::vector<Student> smallRead;
+    std::vector<ParseError> smallReadErrors;
+    auto smallStats = smallReadParser.parseStudentFilesStreaming(streamFiles, [&](DataParser::ParseBatch& batch) {
+        for (const Student& student : batch.students.toStudents()) {
+            smallRead.push_back(student);
+        }
+        smallReadErrors.insert(smallReadErrors.end(), batch.errors.begin(), batch.errors.end());
+    });
+    std::vector<ParseError> expectedStored;
+    for (const auto& result : expected) {
+        expectedStored.insert(expectedStored.end(), result.errors.stored().begin(), result.errors.stored().end());
+    }
+    assert(smallRead == expectedStudents);
+    assert(smallReadErrors == expectedStored);
+    assert(smallStats[0].totalLines == expected[0].totalLines && smallStats[1].validLines == expected[1].validLines);
+    std::cout << "Чтение фрагментами по 20 байт совпадает с полным разбором: "
+              << (smallRead == expectedStudents && smallReadErrors == expectedStored) << std::endl;
+    
+    // Тест 8: Структурированные ошибки с ограничением на файл
+    std::cout << "\n8. Ограниченный журнал ошибок:" << std::endl;
+    std::ofstream broken("student_file_broken.txt");
+    for (int i = 0; i < 1000; ++i) {
+        broken << (i % 2 == 0 ? "x Ivan Ivanov 01.01.1990\n" : "5 Ivan Ivanov 99.99.1990\n");
+    }
+    broken.close();
+    
+    DataParser cappedParser;
+    cappedParser.setMaxErrorsPerFile(3);
+    auto brokenResult = cappedParser.parseStudentFile("student_file_broken.txt");
+    std::cout << "Ошибок всего: " << brokenResult.errors.total()
+              << ", сохранено: " << brokenResult.errors.stored().size()
+              << ", пропущено: " << brokenResult.errors.dropped() << std::endl;
+    std::cout << "Неверный ID: " << brokenResult.errors.count(ParseErrorKind::InvalidId)
+              << ", неверная дата: " << brokenResult.errors.count(ParseErrorKind::InvalidBirthDate) << std::endl;
+    std::cout << "Размер записи об ошибке: " << sizeof(ParseError) << " байт" << std::endl;
+    
+    // Файл изменился и укоротился после разбора: в сообщении поле из разобранной версии
+    std::ofstream rewritten("student_file_broken.txt");
+    rewritten << "1 A B 01.01.1990\n";
+    rewritten.close();
+    std::vector<std::string> brokenMessages = brokenResult.errors.format("student_file_broken.txt");
+    assert(brokenMessages.size() == 3);
+    assert(brokenMessages[0] == "Файл student_file_broken.txt, строка 1: Неверный формат ID: x");
+    assert(brokenMessages[1] ==
+           "Файл student_file_broken.txt, строка 2: Неверная дата рождения: '99.99.1990'");
+    for (const auto& error : brokenMessages) {
+        std::cout << "  " << error << std::endl;
+    }
+    
+    // Длинное поле хранится обрезанным по границе символа
+    ParseError longField;
+    longField.kind = ParseErrorKind::InvalidLastName;
+    longField.line = 7;
+    std::string name;
+    for (int i = 0; i < 20; ++i) {
+        name += "Ж";
+    }
+    longField.setField(name);
+    assert(longField.field().size() == 32 && longField.fieldTruncated());
+    assert(ParseErrorLog::format(longField, "f.txt") ==
+           "Файл f.txt, строка 7: Неверная фамилия: '" + name.substr(0, 32) + "...'");
+    
+    // Поле дальше 65535 байт от начала строки: смещение насыщается, а обрезка
+    // поля по-прежнему видна
+    {
+        std::ofstream wide("student_file_wide.txt");
+        wide << "1 " << std::string(70000, 'A') << " Ivan " << std::string(40, '9') << "\n";
+    }
+    auto wideResult = parser.parseStudentFile("student_file_wide.txt");
+    assert(wideResult.errors.stored().size() == 1);
+    const ParseError& wideError = wideResult.errors.stored()[0];
+    assert(wideError.kind == ParseErrorKind::InvalidBirthDate);
+    assert(wideError.column == UINT16_MAX && wideError.length == 40);
+    assert(wideError.field() == std::string(32, '9') && wideError.fieldTruncated());
+    std::remove("student_file_wide.txt");
+    
+    auto missing = parser.parseStudentFile("missing_file.txt");
+    for (const auto& error : missing.errors.format("missing_file.txt")) {
+        std::cout << "  " << error << std::endl;
+    }
+}
+
+// Разбор строки в виде, удобном для сравнения реализаций
+std::string describeLine(const TextScanner::Line& line) {
+    std::string result = std::string(line.text) + "|" + std::to_string(line.tokenCount) +
+                         (line.comment ? "|comment" : "");
+    for (size_t i = 0; i < std::min(line.tokenCount, TextScanner::Line::HEAD_SIZE); ++i) {
+        result += "|" + std::string(line.head[i]);
+    }
+    return result + "|" + std::string(line.tail);
+}
+
+void testScannerBackends() {
+    std::cout << "\n=== ТЕСТ РЕАЛИЗАЦИЙ TEXT SCANNER ===" << std::endl;
+    
+    // Токены и комментарии на границах 64-байтовых блоков, CRLF, строка без '\n'
+    std::string data = "1 Ivan Ivanov 01.01.1990\r\n\n   \t\n";
+    data += "# " + std::string(70, 'x') + " хвост комментария 1 2 3\n";
+    data += std::string(61, ' ') + ";comment-token crosses block\n";
+    data += "2 " + std::string(100, 'P') + " Petrov Petr Petrovich 02.02.1991\n";
+    data += "3 a#b c;d 03.03.1993";
+    
+    TextScanner::Backend initial = TextScanner::activeBackend();
+    std::vector<std::string> expected;
+    TextScanner::setBackend(TextScanner::Backend::Scalar);
+    {
+        TextScanner::LineTokenizer tokenizer(data);
+        TextScanner::Line line;
+        while (tokenizer.next(line)) {
+            expected.push_back(describeLine(line));
+        }
+    }
+    assert(expected.size() == 7);
+    assert(expected[3].find("|1|comment|#|#") != std::string::npos);
+    assert(expected[4].find("|1|comment|;comment-token|;comment-token") != std::string::npos);
+    assert(expected[6] == "3 a#b c;d 03.03.1993|4|3|a#b|c;d|03.03.1993");
+    assert(TextScanner::countNewlines(data.data(), data.data() + data.size()) == 6);
+    
+    const TextScanner::Backend backends[] = {TextScanner::Backend::Sse2, TextScanner::Backend::Avx2};
+    for (TextScanner::Backend backend : backends) {
+        if (!TextScanner::setBackend(backend)) {
+            continue;
+        }
+        std::vector<std::string> actual;
+        TextScanner::LineTokenizer tokenizer(data);
+        TextScanner::Line line;
+        while (tokenizer.next(line)) {
+            actual.push_back(describeLine(line));
+        }
+        assert(actual == expected);
+        assert(TextScanner::countNewlines(data.data(), data.data() + data.size()) == 6);
+        const char* begin = data.data();
+        const char* end = data.data() + data.size();
+        TextScanner::setBackend(TextScanner::Backend::Scalar);
+        const char* scalarNewline = TextScanner::findNewline(begin + 40, end);
+        const char* scalarToken = TextScanner::skipSpaces(begin + 110, end);
+        TextScanner::setBackend(backend);
+        assert(TextScanner::findNewline(begin + 40, end) == scalarNewline);
+        assert(TextScanner::skipSpaces(begin + 110, end) == scalarToken);
+        std::cout << "✓ " << TextScanner::backendName(backend) << " совпадает со скалярным разбором" << std::endl;
+    }
+    TextScanner::setBackend(initial);
 }
 
 int main() {
     testDataParser();
+    testScannerBackends();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include "../common/mpsc_ring.hpp"
+
+void testSingleThread() {
+    std::cout << "\n=== ТЕСТ ОЧЕРЕДИ В ОДНОМ ПОТОКЕ ===" << std::endl;
+
+    // Ёмкость округляется до степени двойки
+    MpscRing<std::string> ring(5);
+    assert(ring.capacity() == 8);
+    assert(ring.empty());
+
+    for (int i = 0; i < 8; ++i) {
+        assert(ring.tryPush(std::to_string(i)));
+    }
+    assert(ring.size() == 8);
+
+    // При заполненной очереди элемент остаётся у вызывающего
+    std::string rejected = "rejected";
+    assert(!ring.tryPush(std::move(rejected)));
+    assert(rejected == "rejected");
+
+    // Порядок FIFO, в том числе после перехода через конец кольца
+    std::string value;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            assert(ring.tryPop(value));
+            assert(value == std::to_string(round * 8 + i));
+            assert(ring.tryPush(std::to_string((round + 1) * 8 + i)));
+        }
+    }
+    for (int i = 0; i < 8; ++i) {
+        assert(ring.tryPop(value));
+    }
+    assert(!ring.tryPop(value));
+    assert(ring.empty());
+    assert(ring.stats().pushed == 32);
+    assert(ring.stats().highWater == 8);
+
+    std::cout << "Ёмкость, порядок и переполнение работают корректно!" << std::endl;
+}
+
+void testEviction() {
+    std::cout << "\n=== ТЕСТ ВЫТЕСНЕНИЯ СТАРЫХ ЭЛЕМЕНТОВ ===" << std::endl;
+
+    // Производитель освобождает место, забирая самый старый элемент
+    MpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+        assert(ring.tryPush(int(i)));
+    }
+    int evicted = -1;
+    int dropped = 0;
+    for (int i = 4; i < 10; ++i) {
+        while (!ring.tryPush(int(i))) {
+            bool ok = ring.tryEvict(evicted);
+            assert(ok);
+            assert(evicted == dropped);
+            dropped++;
+        }
+    }
+    assert(dropped == 6);
+    assert(ring.stats().highWater == 4);
+
+    // В очереди остались самые новые элементы
+    int value = 0;
+    for (int i = 6; i < 10; ++i) {
+        assert(ring.tryPop(value));
+        assert(value == i);
+    }
+    assert(!ring.tryEvict(evicted));
+
+    // Вытеснение одновременно с потребителем: каждый элемент достаётся ровно одному
+    const int ITEMS = 200000;
+    MpscRing<int> shared(64);
+    std::atomic<bool> stop(false);
+    std::atomic<long long> evictedSum(0);
+    std::thread producer([&] {
+        for (int i = 1; i <= ITEMS; ++i) {
+            int item = i;
+            while (!shared.tryPush(std::move(item))) {
+                int old = 0;
+                if (shared.tryEvict(old)) {
+                    evictedSum += old;
+                }
+            }
+        }
+        stop = true;
+        shared.wakeAll();
+    });
+    long long poppedSum = 0;
+    while (true) {
+        if (!shared.tryPop(value)) {
+            if (stop) {
+                if (!shared.tryPop(value)) {
+                    break;
+                }
+            } else {
+                shared.waitForData(stop);
+                continue;
+            }
+        }
+        poppedSum += value;
+    }
+    producer.join();
+    assert(poppedSum + evictedSum == static_cast<long long>(ITEMS) * (ITEMS + 1) / 2);
+    assert(shared.stats().highWater <= shared.capacity());
+
+    std::cout << "Вытеснено " << dropped << " из 10; под нагрузкой сумма сошлась, "
+              << "наибольшая глубина: " << shared.stats().highWater << std::endl;
+}
+
+void testProducers() {
+    std::cout << "\n=== ТЕСТ НЕСКОЛЬКИХ ПРОИЗВОДИТЕЛЕЙ ===" << std::endl;
+
+    const int PRODUCERS = 4;
+    const int ITEMS = 200000;
+    MpscRing<uint64_t> ring(256);
+    std::atomic<bool> stop(false);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, &stop, p, ITEMS] {
+            for (int i = 0; i < ITEMS; ++i) {
+                uint64_t item = (static_cast<uint64_t>(p) << 32) | static_cast<uint64_t>(i);
+                ring.push(std::move(item), stop);
+            }
+        });
+    }
+
+    // Элементы каждого производителя приходят по порядку и без потерь
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    uint64_t item = 0;
+    while (received < PRODUCERS * ITEMS) {
+        if (!ring.tryPop(item)) {
+            ring.waitForData(stop);
+            continue;
+        }
+        int producer = static_cast<int>(item >> 32);
+        int index = static_cast<int>(item & 0xFFFFFFFF);
+        assert(index == next[producer]);
+        next[producer]++;
+        received++;
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    MpscRing<uint64_t>::Stats stats = ring.stats();
+    assert(stats.pushed == static_cast<size_t>(PRODUCERS * ITEMS));
+    assert(ring.empty());
+
+    std::cout << "Передано " << received << " элементов за "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " мс; повторов CAS: " << stats.contended
+              << ", ожиданий места: " << stats.fullWaits
+              << ", засыпаний потребителя: " << stats.consumerSleeps << std::endl;
+}
+
+void testWakeup() {
+    std::cout << "\n=== ТЕСТ ПРОБУЖДЕНИЯ ПОТРЕБИТЕЛЯ ===" << std::endl;
+
+    MpscRing<std::chrono::steady_clock::time_point> ring(16);
+    std::atomic<bool> stop(false);
+    const int ROUNDS = 200;
+    long long totalMicros = 0;
+    long long maxMicros = 0;
+
+    // Потребитель спит на пустой очереди и просыпается сразу после записи
+    std::thread consumer([&] {
+        std::chrono::steady_clock::time_point sent;
+        for (int i = 0; i < ROUNDS; ++i) {
+            while (!ring.tryPop(sent)) {
+                ring.waitForData(stop);
+            }
+            long long micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - sent).count();
+            totalMicros += micros;
+            maxMicros = std::max(maxMicros, micros);
+        }
+    });
+    for (int i = 0; i < ROUNDS; ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        ring.tryPush(std::chrono::steady_clock::now());
+    }
+    consumer.join();
+    assert(ring.stats().consumerSleeps > 0);
+
+    std::cout << "Задержка выдачи: в среднем " << totalMicros / ROUNDS
+              << " мкс, максимум " << maxMicros << " мкс" << std::endl;
+
+    // Остановка прерывает ожидание данных и места
+    MpscRing<int> full(2);
+    full.tryPush(1);
+    full.tryPush(2);
+    std::thread producer([&] {
+        bool pushed = full.push(3, stop);
+        assert(!pushed);
+    });
+    MpscRing<int> idle(2);
+    std::thread waiter([&] {
+        idle.waitForData(stop);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stop = true;
+    full.wakeAll();
+    idle.wakeAll();
+    producer.join();
+    waiter.join();
+
+    std::cout << "Остановка прерывает ожидание!" << std::endl;
+}
+
+int main() {
+    testSingleThread();
+    testEviction();
+    testProducers();
+    testWakeup();
+
+    std::cout << "\n=== ВСЕ ТЕСТЫ ОЧЕРЕДИ ПРОЙДЕНЫ УСПЕШНО! ===" << std::endl;
+    return 0;
+}
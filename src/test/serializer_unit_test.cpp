@@ -1,8 +1,11 @@
 #include <iostream>
 #include <vector>
 #include <cassert>
+#include <chrono>
+#include <algorithm>
 #include "../common/serializer.hpp"
 #include "../common/student.hpp"
+#include "../common/payload_codec.hpp"
 
 void testStudentSerialization() {
     std::cout << "=== ТЕСТ СЕРИАЛИЗАЦИИ ОДНОГО СТУДЕНТА ===" << std::endl;
@@ -50,6 +53,565 @@ void testStudentsListSerialization() {
     std::cout << "Список успешно сериализован и десериализован!" << std::endl;
 }
 
+void testStudentTableSerialization() {
+    std::cout << "\n=== ТЕСТ СЕРИАЛИЗАЦИИ КОЛОНОЧНОЙ ТАБЛИЦЫ ===" << std::endl;
+    
+    std::vector<Student> students = {
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(2, "Petr", "Petrov", "15.05.1991")
+    };
+    StudentTable table(students);
+    
+    // Таблица и вектор дают один и тот же JSON
+    assert(Serializer::serializeStudents(table) == Serializer::serializeStudents(students));
+    
+    StudentTable table_back = Serializer::deserializeStudentTable(Serializer::serializeStudents(table));
+    assert(table_back.size() == students.size());
+    for (size_t row = 0; row < table_back.size(); ++row) {
+        assert(table_back.student(row) == students[row]);
+        assert(table_back.id(row) == students[row].getId());
+    }
+    
+    std::cout << "Таблица успешно сериализована и десериализована!" << std::endl;
+}
+
+void testBinarySerialization() {
+    std::cout << "\n=== ТЕСТ ДВОИЧНОГО ФОРМАТА ===" << std::endl;
+    
+    std::vector<Student> students = {
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(2, "Petr", "Ivanov", "15.05.1991"),
+        Student(300000, "Анна", "Сидорова", "20.03.1900")
+    };
+    StudentTable table(students);
+    
+    std::string binary = BinarySerializer::serializeStudents(students);
+    assert(BinarySerializer::serializeStudents(table) == binary);
+    assert(Serializer::detectFormat(binary) == Serializer::Format::Binary);
+    assert(Serializer::detectFormat(Serializer::serializeStudents(students)) == Serializer::Format::Json);
+    
+    // Автоопределение формата при декодировании
+    assert(Serializer::decodeStudents(binary) == students);
+    assert(Serializer::decodeStudents(Serializer::serializeStudents(students)) == students);
+    
+    StudentTable table_back = BinarySerializer::deserializeStudentTable(binary);
+    assert(table_back.size() == students.size());
+    for (size_t row = 0; row < table_back.size(); ++row) {
+        assert(table_back.student(row) == students[row]);
+    }
+    
+    // Повреждённые данные и неизвестная версия отклоняются
+    bool truncatedRejected = false;
+    try {
+        BinarySerializer::deserializeStudents(binary.substr(0, binary.size() - 3));
+    } catch (const std::invalid_argument&) {
+        truncatedRejected = true;
+    }
+    assert(truncatedRejected);
+    
+    std::string future = binary;
+    future[4] = static_cast<char>(BinarySerializer::VERSION + 1);
+    bool versionRejected = false;
+    try {
+        BinarySerializer::deserializeStudents(future);
+    } catch (const std::invalid_argument&) {
+        versionRejected = true;
+    }
+    assert(versionRejected);
+    
+    // Размер и время декодирования большого снимка
+    const char* lastNames[] = {"Ivanov", "Petrov", "Sidorova", "Kuznetsov", "Smirnova"};
+    const char* firstNames[] = {"Ivan", "Petr", "Anna", "Maria", "Oleg", "Elena"};
+    std::vector<Student> large;
+    for (int i = 0; i < 100000; ++i) {
+        large.emplace_back(i, firstNames[i % 6], lastNames[i % 5],
+                           Date::fromDays(7000 + i % 9000));
+    }
+    std::string largeJson = Serializer::serializeStudents(large);
+    std::string largeBinary = BinarySerializer::serializeStudents(large);
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Student> fromJson = Serializer::decodeStudents(largeJson);
+    auto middle = std::chrono::steady_clock::now();
+    std::vector<Student> fromBinary = Serializer::decodeStudents(largeBinary);
+    auto end = std::chrono::steady_clock::now();
+    assert(fromJson == large && fromBinary == large);
+    
+    std::cout << "Снимок из " << large.size() << " студентов: JSON " << largeJson.size()
+              << " байт, двоичный " << largeBinary.size() << " байт" << std::endl;
+    std::cout << "Декодирование: JSON "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count()
+              << " мс, двоичный "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count()
+              << " мс" << std::endl;
+    
+    std::cout << "Двоичный формат работает корректно!" << std::endl;
+}
+
+// Список после sortStudentsByName: порядок по ФИО, записи с одинаковым ФИО - по дате
+std::vector<Student> sortedByName(std::vector<Student> students) {
+    std::sort(students.begin(), students.end(), [](const Student& a, const Student& b) {
+        if (a < b || b < a) {
+            return a < b;
+        }
+        return a.getBirthDateValue().daysSinceEpoch() < b.getBirthDateValue().daysSinceEpoch();
+    });
+    return students;
+}
+
+// Совпадение списков без учёта порядка внутри групп с одинаковым ФИО
+bool sameContents(const std::vector<Student>& a, const std::vector<Student>& b) {
+    std::vector<Student> left = sortedByName(a);
+    std::vector<Student> right = sortedByName(b);
+    if (left.size() != right.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+        if (!(left[i] == right[i]) || left[i].getId() != right[i].getId()) {
+            return false;
+        }
+    }
+    return std::is_sorted(a.begin(), a.end());
+}
+
+void testStudentDelta() {
+    std::cout << "\n=== ТЕСТ ИЗМЕНЕНИЙ СПИСКА ===" << std::endl;
+    
+    std::vector<Student> previous = sortedByName({
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(2, "Ivan", "Ivanov", "02.02.1991"),
+        Student(3, "Petr", "Petrov", "03.03.1992"),
+        Student(4, "Anna", "Sidorova", "04.04.1993"),
+        Student(5, "Oleg", "Zaitsev", "05.05.1994")
+    });
+    std::vector<Student> current = sortedByName({
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(20, "Ivan", "Ivanov", "02.02.1991"),   // изменён ID
+        Student(6, "Ivan", "Ivanov", "06.06.1996"),    // тёзка добавлен
+        Student(4, "Anna", "Sidorova", "04.04.1993"),
+        Student(7, "Boris", "Avdeev", "07.07.1997")    // добавлен в начало
+    });
+    
+    StudentDelta delta = StudentDelta::compute(StudentTable(previous), StudentTable(current));
+    assert(delta.added.size() == 2);
+    assert(delta.removed.size() == 2);
+    assert(delta.modified.size() == 1 && delta.modified[0].getId() == 20);
+    assert(StudentDelta::compute(StudentTable(current), StudentTable(current)).empty());
+    
+    std::vector<Student> applied = previous;
+    delta.apply(applied);
+    assert(sameContents(applied, current));
+    
+    // Запись встречается в списке дважды: удаляется и меняется только одна,
+    // при точечном применении и при проходе по всему списку одинаково
+    std::vector<Student> repeated = sortedByName({
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(3, "Petr", "Petrov", "03.03.1992"),
+        Student(3, "Petr", "Petrov", "03.03.1992")
+    });
+    StudentDelta single;
+    single.removed.push_back(Student(1, "Ivan", "Ivanov", "01.01.1990"));
+    single.modified.push_back(Student(30, "Petr", "Petrov", "03.03.1992"));
+    StudentDelta bulk = single;
+    for (int i = 0; i < static_cast<int>(StudentDelta::POINT_UPDATE_LIMIT); ++i) {
+        bulk.added.push_back(Student(100 + i, "Name" + std::to_string(i), "Zaitsev", "01.01.2000"));
+    }
+    for (const StudentDelta* change : {&single, &bulk}) {
+        std::vector<Student> target = repeated;
+        change->apply(target);
+        assert(target.size() == 3 + change->added.size());
+        assert(std::count(target.begin(), target.end(), repeated[0]) == 1);
+        assert(target[1].getId() + target[2].getId() == 33);
+    }
+    
+    // Двоичное кодирование изменения и версии снимка
+    delta.baseVersion = 41;
+    delta.version = 42;
+    std::string encoded;
+    BinarySerializer::serializeDelta(delta, encoded);
+    assert(BinarySerializer::readVersion(encoded) == 42);
+    StudentDelta decoded = BinarySerializer::deserializeDelta(encoded);
+    assert(decoded.baseVersion == 41 && decoded.version == 42);
+    assert(decoded.added == delta.added && decoded.removed == delta.removed);
+    assert(decoded.modified.size() == 1 && decoded.modified[0].getId() == 20);
+    
+    std::string snapshot;
+    BinarySerializer::serializeStudents(current, snapshot, 42);
+    assert(BinarySerializer::readVersion(snapshot) == 42);
+    assert(BinarySerializer::deserializeStudents(snapshot) == current);
+    
+    // Снимок не принимается вместо изменения и наоборот
+    bool kindRejected = false;
+    try {
+        BinarySerializer::deserializeDelta(snapshot);
+    } catch (const std::invalid_argument&) {
+        kindRejected = true;
+    }
+    assert(kindRejected);
+    
+    // Большой список: точечные правки и крупное изменение (проход слиянием)
+    const char* lastNames[] = {"Ivanov", "Petrov", "Sidorova", "Kuznetsov", "Smirnova", "Orlov", "Volkov"};
+    std::vector<Student> large;
+    for (int i = 0; i < 200000; ++i) {
+        large.emplace_back(i, "Имя" + std::to_string(i % 1000), lastNames[i % 7],
+                           Date::fromDays(5000 + i % 7919));
+    }
+    large = sortedByName(large);
+    StudentTable largeTable(large);
+    
+    for (size_t changes : {size_t(5), size_t(5000)}) {
+        std::vector<Student> edited = large;
+        for (size_t k = 0; k < changes; ++k) {
+            size_t row = (k * 7919) % edited.size();
+            edited[row].setId(1000000 + static_cast<int>(k));
+        }
+        edited.erase(edited.begin() + 10, edited.begin() + 10 + changes);
+        for (size_t k = 0; k < changes; ++k) {
+            edited.emplace_back(500000 + static_cast<int>(k), "Новый" + std::to_string(k), "Яковлев",
+                                Date::fromDays(static_cast<int32_t>(k)));
+        }
+        edited = sortedByName(edited);
+        StudentTable editedTable(edited);
+        
+        std::vector<Student> target = large;
+        auto start = std::chrono::steady_clock::now();
+        StudentDelta largeDelta = StudentDelta::compute(largeTable, editedTable);
+        auto middle = std::chrono::steady_clock::now();
+        largeDelta.apply(target);
+        auto end = std::chrono::steady_clock::now();
+        assert(sameContents(target, edited));
+        
+        std::string deltaMessage;
+        BinarySerializer::serializeDelta(largeDelta, deltaMessage);
+        std::cout << "Изменений " << largeDelta.size() << " в " << large.size()
+                  << " записях: сообщение " << deltaMessage.size() << " байт против снимка "
+                  << BinarySerializer::serializeStudents(editedTable).size() << " байт, расчёт "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count()
+                  << " мс, применение "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count()
+                  << " мкс" << std::endl;
+    }
+    
+    std::cout << "Изменения списка работают корректно!" << std::endl;
+}
+
+void testSnapshotChunks() {
+    std::cout << "\n=== ТЕСТ СНИМКА ЧАСТЯМИ ===" << std::endl;
+    
+    std::vector<Student> students;
+    for (int i = 0; i < 10000; ++i) {
+        students.emplace_back(i, "Имя" + std::to_string(i % 100), "Фамилия" + std::to_string(i % 37),
+                              Date::fromDays(4000 + i % 3000));
+    }
+    StudentTable table(students);
+    
+    // Части разбираются независимо и в сумме дают исходный список
+    const size_t CHUNK = 3000;
+    const size_t COUNT = 4;
+    std::vector<Student> assembled;
+    size_t largestChunk = 0;
+    std::string message;
+    for (size_t index = 0; index < COUNT; ++index) {
+        size_t begin = index * CHUNK;
+        size_t end = std::min(begin + CHUNK, students.size());
+        BinarySerializer::serializeSnapshotChunk(table, begin, end, 7, index, COUNT, message);
+        largestChunk = std::max(largestChunk, message.size());
+        
+        BinarySerializer::Header header;
+        assert(BinarySerializer::readHeader(message, header));
+        assert(header.kind == BinarySerializer::MessageKind::SnapshotChunk);
+        assert(BinarySerializer::readVersion(message) == 7);
+        
+        BinarySerializer::SnapshotChunk chunk = BinarySerializer::deserializeSnapshotChunk(message);
+        assert(chunk.version == 7 && chunk.index == index && chunk.count == COUNT);
+        assert(chunk.totalRecords == students.size());
+        assert(chunk.students.size() == end - begin);
+        assembled.insert(assembled.end(), chunk.students.begin(), chunk.students.end());
+    }
+    assert(assembled == students);
+    
+    // Часть не разбирается как целый снимок, повреждённая часть отклоняется
+    bool kindRejected = false;
+    try {
+        BinarySerializer::deserializeStudents(message);
+    } catch (const std::invalid_argument&) {
+        kindRejected = true;
+    }
+    assert(kindRejected);
+    
+    bool truncatedRejected = false;
+    try {
+        BinarySerializer::deserializeSnapshotChunk(message.substr(0, message.size() / 2));
+    } catch (const std::invalid_argument&) {
+        truncatedRejected = true;
+    }
+    assert(truncatedRejected);
+    
+    std::string whole = BinarySerializer::serializeStudents(table);
+    std::cout << "Снимок " << whole.size() << " байт передаётся " << COUNT
+              << " частями, наибольшая " << largestChunk << " байт" << std::endl;
+    std::cout << "Снимок частями работает корректно!" << std::endl;
+}
+
+// Эталон: прежняя сериализация через DOM nlohmann::json
+json referenceJson(const std::vector<Student>& students) {
+    json j;
+    j["students"] = json::array();
+    for (const Student& student : students) {
+        j["students"].push_back(Serializer::studentToJson(student));
+    }
+    return j;
+}
+
+void testPayloadCompression() {
+    std::cout << "\n=== ТЕСТ СЖАТИЯ СООБЩЕНИЙ ===" << std::endl;
+    
+    if (!PayloadCodec::available()) {
+        std::cout << "Сборка без zstd, тест пропущен" << std::endl;
+        return;
+    }
+    
+    const char* firstNames[] = {"Александр", "Мария", "Дмитрий", "Анна", "Сергей", "Елена",
+                                "Андрей", "Ольга", "Иван", "Наталья", "Михаил", "Татьяна"};
+    const char* lastNames[] = {"Иванов", "Петрова", "Смирнов", "Кузнецова", "Попов", "Васильева",
+                               "Соколов", "Михайлова", "Новиков", "Фёдорова", "Морозов", "Волкова"};
+    std::vector<Student> students;
+    for (int i = 0; i < 20000; ++i) {
+        students.emplace_back(100000 + i, firstNames[i % 12], lastNames[(i / 12) % 12],
+                              Date::fromDays(10000 + (i * 7) % 2500));
+    }
+    std::sort(students.begin(), students.end());
+    StudentTable table(students);
+    
+    // Словарь обучается на небольших частях, как на сервере
+    std::vector<std::string> samples;
+    for (size_t begin = 0; begin < table.size(); begin += 64) {
+        samples.emplace_back();
+        BinarySerializer::serializeSnapshotChunk(table, begin, std::min(begin + 64, table.size()),
+                                                 1, 0, 1, samples.back());
+    }
+    std::string dictionary = PayloadCodec::trainDictionary(samples);
+    assert(!dictionary.empty());
+    PayloadCodec codec(dictionary);
+    PayloadCodec plainCodec;
+    assert(codec.dictionaryId() != 0 && plainCodec.dictionaryId() == 0);
+    
+    // Снимок: заголовок сохраняется, тело распаковывается без потерь
+    std::string snapshot;
+    BinarySerializer::serializeStudents(table, snapshot, 3);
+    std::string compressed;
+    std::string restored;
+    assert(codec.compress(snapshot, compressed));
+    assert(PayloadCodec::isCompressed(compressed));
+    assert(PayloadCodec::messageDictionaryId(compressed) == codec.dictionaryId());
+    BinarySerializer::Header header;
+    assert(BinarySerializer::readHeader(compressed, header));
+    assert(header.kind == BinarySerializer::MessageKind::Snapshot);
+    codec.decompress(compressed, restored);
+    assert(restored == snapshot);
+    assert(BinarySerializer::deserializeStudents(restored) == students);
+    
+    // Небольшое изменение: выигрыш даёт словарь
+    StudentDelta delta;
+    delta.baseVersion = 3;
+    delta.version = 4;
+    delta.added.assign(students.begin(), students.begin() + 20);
+    std::string deltaMessage;
+    BinarySerializer::serializeDelta(delta, deltaMessage);
+    std::string deltaCompressed;
+    std::string deltaPlain;
+    assert(codec.compress(deltaMessage, deltaCompressed));
+    bool plainCompressed = plainCodec.compress(deltaMessage, deltaPlain);
+    codec.decompress(deltaCompressed, restored);
+    assert(BinarySerializer::deserializeDelta(restored).added.size() == 20);
+    
+    // Сжатое тело не разбирается напрямую, чужой словарь отклоняется
+    bool compressedRejected = false;
+    try {
+        BinarySerializer::deserializeStudents(compressed);
+    } catch (const std::invalid_argument&) {
+        compressedRejected = true;
+    }
+    assert(compressedRejected);
+    
+    bool dictionaryRejected = false;
+    try {
+        plainCodec.decompress(compressed, restored);
+    } catch (const std::invalid_argument&) {
+        dictionaryRejected = true;
+    }
+    assert(dictionaryRejected);
+    
+    // JSON не сжимается: кодек работает только с двоичными сообщениями
+    std::string json = Serializer::serializeStudents(students);
+    std::string unused;
+    assert(!codec.compress(json, unused));
+    
+    std::cout << "Словарь: " << dictionary.size() << " байт" << std::endl;
+    std::cout << "Снимок: JSON " << json.size() << ", двоичный " << snapshot.size()
+              << ", сжатый " << compressed.size() << " байт" << std::endl;
+    std::cout << "Изменение: " << deltaMessage.size() << " -> " << deltaCompressed.size()
+              << " байт со словарём, "
+              << (plainCompressed ? std::to_string(deltaPlain.size()) + " байт" : "не сжимается")
+              << " без словаря" << std::endl;
+    std::cout << "Сжатие сообщений работает корректно!" << std::endl;
+}
+
+void testJsonWriter() {
+    std::cout << "\n=== ТЕСТ ПОТОКОВОЙ ЗАПИСИ JSON ===" << std::endl;
+    
+    std::vector<Student> students = {
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(2, "Jean \"Quote\"", "Back\\slash", "15.05.1991"),
+        Student(3, "Tab\tNew\nLine\x01", "Сидорова", "20.03.1992"),
+        Student(4, "No", "Date", "")
+    };
+    json reference = referenceJson(students);
+    
+    // Вывод совпадает байт в байт с dump() и dump(4)
+    std::string compact;
+    Serializer::writeStudents(students, compact);
+    assert(compact == reference.dump());
+    assert(Serializer::serializeStudents(students) == reference.dump(4));
+    
+    std::string fromTable;
+    Serializer::writeStudents(StudentTable(students), fromTable);
+    assert(fromTable == compact);
+    
+    // Пустой список
+    std::string empty;
+    Serializer::writeStudents(std::vector<Student>(), empty, 4);
+    assert(empty == referenceJson({}).dump(4));
+    
+    // Буфер переиспользуется: содержимое заменяется, память остаётся
+    std::string buffer;
+    Serializer::writeStudents(students, buffer);
+    size_t capacity = buffer.capacity();
+    Serializer::writeStudents(std::vector<Student>(students.begin(), students.begin() + 1), buffer);
+    assert(buffer == referenceJson({students[0]}).dump());
+    assert(buffer.capacity() == capacity);
+    
+    std::cout << "Компактный JSON: " << compact.substr(0, 90) << "..." << std::endl;
+    std::cout << "Потоковая запись совпадает с DOM-сериализацией!" << std::endl;
+}
+
+// Прежний разбор через DOM - эталон для проверки событийного декодера
+std::vector<Student> referenceDecode(const std::string& data) {
+    std::vector<Student> students;
+    try {
+        json j = json::parse(data);
+        if (!j.contains("students") || !j["students"].is_array()) {
+            throw std::invalid_argument("Invalid students JSON format");
+        }
+        for (const json& studentJson : j["students"]) {
+            if (Serializer::validateStudentJson(studentJson)) {
+                students.push_back(Serializer::jsonToStudent(studentJson));
+            }
+        }
+    } catch (const json::parse_error& e) {
+        throw std::invalid_argument("JSON parse error: " + std::string(e.what()));
+    }
+    return students;
+}
+
+// Текст исключения или пустая строка, если декодирование прошло успешно
+template <typename Decode>
+std::string decodeError(const Decode& decode, const std::string& data, std::vector<Student>& result) {
+    try {
+        result = decode(data);
+    } catch (const std::invalid_argument& e) {
+        return e.what();
+    }
+    return std::string();
+}
+
+bool sameStudents(const std::vector<Student>& a, const std::vector<Student>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].getId() != b[i].getId() || !(a[i] == b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testSaxDecoding() {
+    std::cout << "\n=== ТЕСТ СОБЫТИЙНОГО РАЗБОРА JSON ===" << std::endl;
+    
+    const std::vector<std::string> inputs = {
+        R"({"students":[{"id":1,"first_name":"Ivan","last_name":"Ivanov","birth_date":"01.01.1990"}]})",
+        R"({"students":[]})",
+        // Посторонние ключи и вложенные значения вне полей записи
+        R"({"meta":{"students":[1]},"students":[{"x":[{"id":5}],"id":2,"first_name":"A","last_name":"B","birth_date":"02.02.1992","extra":{"a":1}}]})",
+        // Неверные типы полей и элементы-не-объекты пропускаются
+        R"({"students":[1,"s",null,[],{"id":"3","first_name":"A","last_name":"B","birth_date":"x"},{"id":3.5,"first_name":"A","last_name":"B","birth_date":"x"},{"id":4,"first_name":{"n":"A"},"last_name":"B","birth_date":"x"},{"id":4,"first_name":"A","last_name":["B"],"birth_date":"x"},{"first_name":"A","last_name":"B","birth_date":"x"},{"id":6,"first_name":"C","last_name":"D","birth_date":"03.03.1993"}]})",
+        // Повторные ключи: побеждает последнее значение
+        R"({"students":[{"id":1,"first_name":"A","last_name":"B","birth_date":"x"}],"students":[{"id":7,"first_name":"E","last_name":"F","birth_date":"04.04.1994"}]})",
+        R"({"students":[{"id":1,"first_name":"A","last_name":"B","birth_date":"x"}],"students":{}})",
+        R"({"students":5,"students":[{"id":8,"first_name":"G","last_name":"H","birth_date":"05.05.1995"}]})",
+        R"({"students":[{"id":9,"id":"bad","first_name":"A","last_name":"B","birth_date":"x"},{"id":"bad","id":10,"first_name":"I","first_name":"J","last_name":"K","birth_date":"06.06.1996"}]})",
+        // Большие и отрицательные id
+        R"({"students":[{"id":4294967297,"first_name":"A","last_name":"B","birth_date":"x"},{"id":-12,"first_name":"C","last_name":"D","birth_date":"01.01.2000"}]})",
+        // Ошибки формата
+        R"([1,2,3])",
+        R"("students")",
+        R"({"other":[]})",
+        R"({"students":{"id":1}})",
+        R"({})",
+        // Синтаксические ошибки важнее ошибок формата
+        R"({"students":[{"id":1,}]})",
+        R"({"other":[] )",
+        R"({"students":[]} trailing)",
+        "",
+        R"({"students":[{"id":1,"first_name":"\uZZZZ"}]})"
+    };
+    
+    for (const std::string& input : inputs) {
+        std::vector<Student> expected;
+        std::vector<Student> actual;
+        std::vector<Student> fromTable;
+        std::string expectedError = decodeError(referenceDecode, input, expected);
+        std::string actualError = decodeError(
+            [](const std::string& data) { return Serializer::deserializeStudents(data); },
+            input, actual);
+        std::string tableError = decodeError(
+            [](const std::string& data) { return Serializer::deserializeStudentTable(data).toStudents(); },
+            input, fromTable);
+        
+        assert(actualError == expectedError);
+        assert(tableError == expectedError);
+        if (expectedError.empty()) {
+            assert(sameStudents(actual, expected));
+            assert(sameStudents(fromTable, expected));
+        }
+    }
+    std::cout << "Проверено входов: " << inputs.size() << ", результаты совпадают с DOM" << std::endl;
+    
+    // Большой список: время разбора через DOM и событийным декодером
+    std::vector<Student> students;
+    for (int i = 0; i < 200000; ++i) {
+        students.emplace_back(i, "Имя" + std::to_string(i % 500), "Фамилия" + std::to_string(i % 700),
+                              "01.02.2000");
+    }
+    std::string data = Serializer::serializeStudents(students);
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Student> viaDom = referenceDecode(data);
+    auto middle = std::chrono::steady_clock::now();
+    std::vector<Student> viaSax = Serializer::deserializeStudents(data);
+    auto end = std::chrono::steady_clock::now();
+    assert(sameStudents(viaSax, viaDom));
+    
+    std::cout << "Разбор " << students.size() << " записей: DOM "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count()
+              << " мс, SAX "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count()
+              << " мс" << std::endl;
+}
+
 void testValidation() {
     std::cout << "\n=== ТЕСТ ВАЛИДАЦИИ JSON ===" << std::endl;
     
@@ -85,6 +647,62 @@ void testValidation() {
     
     assert(Serializer::validateStudentJson(invalid_json2) == false);
     
+    // Значения полей: ID вне диапазона, пустое имя, невалидная дата
+    json out_of_range = valid_json;
+    out_of_range["id"] = 4294967297LL;
+    assert(!Serializer::validateStudentJson(out_of_range));
+    json empty_name = valid_json;
+    empty_name["first_name"] = "";
+    assert(!Serializer::validateStudentJson(empty_name));
+    json bad_date = valid_json;
+    bad_date["birth_date"] = "31.02.1990";
+    assert(!Serializer::validateStudentJson(bad_date));
+    
+    // Одни и те же записи вне правил пропускаются и в JSON, и в двоичном формате
+    std::vector<Student> mixed = {
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(-5, "Petr", "Petrov", "01.01.1990"),
+        Student(2, std::string("A\x01"), "Control", "01.01.1990"),
+        Student(3, std::string(Student::MAX_NAME_BYTES + 1, 'A'), "Long", "01.01.1990"),
+        Student(4, "Anna", "Dateless", Date()),
+        Student(5, "Olga", "Ancient", Date::fromDays(-1000000)),
+        Student(6, "Анна", "Сидорова", "20.03.1992")
+    };
+    std::vector<Student> valid = {mixed[0], mixed[6]};
+    std::vector<Student> fromJson = Serializer::deserializeStudents(Serializer::serializeStudents(mixed));
+    std::string binary = BinarySerializer::serializeStudents(mixed);
+    assert(fromJson == valid && fromJson[1].getId() == 6);
+    assert(BinarySerializer::deserializeStudents(binary) == valid);
+    assert(BinarySerializer::deserializeStudentTable(binary).toStudents() == valid);
+    
+    // Двоичные записи, которые в JSON не передать: ID больше int и имя не в UTF-8
+    std::string raw;
+    BinarySerializer::writeHeader(BinarySerializer::Header(), raw);
+    auto varint = [&raw](uint64_t value) {
+        while (value >= 0x80) {
+            raw.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        raw.push_back(static_cast<char>(value));
+    };
+    auto record = [&](uint64_t zigzagId, const std::string& lastName) {
+        varint(zigzagId);
+        varint(0);
+        varint(lastName.size());
+        raw += lastName;
+        varint(0);
+        varint(1);
+        raw += "A";
+        varint(static_cast<uint64_t>(Date::parse("01.01.1990").daysSinceEpoch()) << 1);
+    };
+    varint(1);                         // версия
+    varint(3);                         // записей
+    record(uint64_t(4294967297) << 1, "Big");
+    record(7 << 1, std::string("\xff\xfe"));
+    record(8 << 1, "Good");
+    std::vector<Student> decoded = BinarySerializer::deserializeStudents(raw);
+    assert(decoded.size() == 1 && decoded[0].getId() == 8 && decoded[0].getLastName() == "Good");
+    
     std::cout << "Валидация работает корректно!" << std::endl;
 }
 
@@ -110,6 +728,13 @@ int main() {
     try {
         testStudentSerialization();
         testStudentsListSerialization();
+        testStudentTableSerialization();
+        testBinarySerialization();
+        testStudentDelta();
+        testSnapshotChunks();
+        testPayloadCompression();
+        testJsonWriter();
+        testSaxDecoding();
         testValidation();
         testEdgeCases();
         
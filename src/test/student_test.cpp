@@ -1,7 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cassert>
 #include "../common/student.hpp"
+#include "../common/student_shard.hpp"
 
 void testStudent() {
     std::cout << "=== ТЕСТИРОВАНИЕ КЛАССА STUDENT ===" << std::endl;
@@ -80,9 +82,101 @@ void testStudent() {
     // Тест 10: Вывод студента после изменений
     std::cout << "\n10. Студент после изменений:" << std::endl;
     s10.print();
+    
+    // Тест 11: Интернирование имён
+    std::cout << "\n11. Интернирование имён:" << std::endl;
+    Student s11(11, "Ivanov", "Petr", "01.02.1991");
+    std::cout << "Общий адрес имени у s1 и s11: "
+              << (s1.getFirstName().data() == s11.getFirstName().data()) << std::endl;
+    std::cout << "Уникальных имён в пуле: " << NamePool::global().uniqueNames() << std::endl;
+    std::cout << "Размер арены: " << NamePool::global().arenaBytes() << " байт" << std::endl;
+    
+    // Тест 12: Компактная дата
+    std::cout << "\n12. Компактная дата:" << std::endl;
+    Date date = Date::parse("04.5.1987");
+    std::cout << "04.5.1987 -> " << date.toString() 
+              << " (дней от эпохи: " << date.daysSinceEpoch() << ")" << std::endl;
+    std::cout << "Размер Date: " << sizeof(Date) << " байт, Student: " << sizeof(Student) << " байт" << std::endl;
+    std::cout << "31.04.2000 валидна: " << Date::parse("31.04.2000").isValid() << std::endl;
+}
+
+void testStudentSharder() {
+    std::cout << "\n=== ТЕСТИРОВАНИЕ РАЗБИЕНИЯ НА ТЕМЫ ===" << std::endl;
+    
+    StudentTable students(std::vector<Student>{
+        Student(5, "Alexey", "Alexeev", "20.03.1989"),
+        Student(1200, "Ivan", "Ivanov", "01.01.1990"),
+        Student(999, "Anna", "Ivanova", "02.02.1991"),
+        Student(-3, "Petr", "Petrov", "10.10.1990")
+    });
+    
+    // Темы по диапазонам ID: начало диапазона дополнено нулями, отрицательные вниз
+    assert(StudentSharder::idRangeTopic(5, 1000) == "id/0000000000/");
+    assert(StudentSharder::idRangeTopic(1200, 1000) == "id/0000001000/");
+    assert(StudentSharder::idRangeTopic(-3, 1000) == "id/-000001000/");
+    assert(StudentSharder::fileTopic("../database/student_file_1.txt") == "file/student_file_1/");
+    assert(StudentSharder::initialTopic("Иванов") == "initial/И/");
+    
+    // Подписка на тему - префикс только самой темы: файл _1 не захватывает _10
+    std::string file1 = StudentSharder::fileTopic("db/student_file_1.txt");
+    std::string file10 = StudentSharder::fileTopic("db/student_file_10.txt");
+    assert(file10.compare(0, file1.size(), file1) != 0);
+    assert(file1.compare(0, file1.size(), file1) == 0);
+    std::string id1 = StudentSharder::idRangeTopic(1000, 1000);
+    assert(StudentSharder::idRangeTopic(10000, 1000).compare(0, id1.size(), id1) != 0);
+    
+    std::map<std::string, StudentTable> byId =
+        StudentSharder::shard(students, StudentSharder::Mode::IdRange, 1000);
+    assert(byId.size() == 3);
+    assert(byId["id/0000000000/"].size() == 2);
+    assert(byId["id/0000000000/"].id(1) == 999);  // порядок внутри шарда сохранён
+    
+    // Каждая запись ровно в одном шарде
+    std::map<std::string, StudentTable> byInitial =
+        StudentSharder::shard(students, StudentSharder::Mode::LastNameInitial);
+    size_t total = 0;
+    for (const auto& shard : byInitial) {
+        total += shard.second.size();
+        std::cout << shard.first << ": " << shard.second.size() << std::endl;
+    }
+    assert(byInitial.size() == 3 && total == students.size());
+    assert(byInitial["initial/I/"].size() == 2);
+    
+    // Без разбиения - один шард с пустой темой
+    assert(StudentSharder::shard(students, StudentSharder::Mode::None).count("") == 1);
+    
+    StudentSharder::Mode mode = StudentSharder::Mode::None;
+    assert(StudentSharder::parseMode("initial", mode) && mode == StudentSharder::Mode::LastNameInitial);
+    assert(!StudentSharder::parseMode("faculty", mode));
+    
+    std::cout << "Разбиение на темы работает корректно!" << std::endl;
+}
+
+void testStudentTable() {
+    std::cout << "\n=== ТЕСТИРОВАНИЕ КОЛОНОЧНОЙ ТАБЛИЦЫ ===" << std::endl;
+    
+    StudentTable table(std::vector<Student>{
+        Student(1, "Ivan", "Ivanov", "01.01.1990"),
+        Student(2, "Anna", "Petrova", "02.02.1991")
+    });
+    
+    // Добавление таблицы и строки к самой себе: колонки растут, источник не портится
+    table.appendTable(table);
+    assert(table.size() == 4);
+    assert(table.id(2) == 1 && table.lastName(2) == "Ivanov" && table.firstName(3) == "Anna");
+    for (int i = 0; i < 64; ++i) {
+        table.appendRow(table, 1);
+    }
+    assert(table.size() == 68);
+    assert(table.lastName(67) == "Petrova" && table.firstName(67) == "Anna");
+    assert(table.birthDate(67) == Date::parse("02.02.1991"));
+    
+    std::cout << "Колоночная таблица работает корректно!" << std::endl;
 }
 
 int main() {
     testStudent();
+    testStudentTable();
+    testStudentSharder();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+// Микро-бенчмарк разбора строк и токенов: пропускная способность в ГБ/с
+// для прежних путей разбора и для всех доступных реализаций TextScanner.
+// Запуск: ./scanner_bench [размер_данных_МБ]
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+#include <algorithm>
+#include "../server/text_scanner.hpp"
+
+// Синтетический файл студентов: разные длины полей, отчество через строку,
+// комментарии, пустые строки и CRLF
+std::string generateData(size_t bytes) {
+    static const char* lastNames[] = {"Ivanov", "Petrova", "Sidorov", "Kuznetsova", "Rimsky-Korsakov"};
+    static const char* firstNames[] = {"Ivan", "Anna", "Petr", "Maria", "Nikolai"};
+    static const char* patronymics[] = {"Ivanovich", "Petrovna", "Sergeevich"};
+
+    std::string data;
+    data.reserve(bytes + 128);
+    unsigned seed = 12345;
+    size_t id = 1;
+    while (data.size() < bytes) {
+        seed = seed * 1103515245 + 12345;
+        unsigned r = seed >> 8;
+        if (r % 97 == 0) {
+            data += "# комментарий\n";
+            continue;
+        }
+        if (r % 89 == 0) {
+            data += "\n";
+            continue;
+        }
+        data += std::to_string(id++);
+        data += ' ';
+        data += lastNames[r % 5];
+        data += "  ";
+        data += firstNames[(r >> 3) % 5];
+        if (r & 1) {
+            data += '\t';
+            data += patronymics[(r >> 6) % 3];
+        }
+        data += ' ';
+        data += std::to_string(1 + r % 28) + "." + std::to_string(1 + (r >> 5) % 12) + "." +
+                std::to_string(1980 + (r >> 9) % 30);
+        data += (r & 2) ? "\r\n" : "\n";
+    }
+    return data;
+}
+
+// Исходный путь: std::getline + trim + stringstream (до перехода на mmap)
+size_t legacyStreamPath(const std::string& data) {
+    std::istringstream input(data);
+    std::string line;
+    size_t tokens = 0;
+    while (std::getline(input, line)) {
+        size_t start = line.find_first_not_of(" \t\r\n\v\f");
+        if (start == std::string::npos) continue;
+        size_t end = line.find_last_not_of(" \t\r\n\v\f");
+        std::string cleaned = line.substr(start, end - start + 1);
+        if (cleaned[0] == '#' || cleaned[0] == ';') continue;
+
+        std::stringstream ss(cleaned);
+        std::string token;
+        std::vector<std::string> fields;
+        while (ss >> token) {
+            fields.push_back(token);
+        }
+        tokens += fields.size();
+    }
+    return tokens;
+}
+
+// Побайтовый разбор по string_view (путь парсера до TextScanner)
+size_t scalarViewPath(const std::string& data) {
+    auto isSpace = TextScanner::isSpace;
+    const char* pos = data.data();
+    const char* end = data.data() + data.size();
+    size_t tokens = 0;
+    while (pos < end) {
+        const char* lineEnd = pos;
+        while (lineEnd < end && *lineEnd != '\n') ++lineEnd;
+        const char* p = pos;
+        pos = lineEnd < end ? lineEnd + 1 : end;
+
+        while (p < lineEnd && isSpace(*p)) ++p;
+        if (p == lineEnd || *p == '#' || *p == ';') continue;
+        while (p < lineEnd) {
+            while (p < lineEnd && isSpace(*p)) ++p;
+            if (p == lineEnd) break;
+            while (p < lineEnd && !isSpace(*p)) ++p;
+            tokens++;
+        }
+    }
+    return tokens;
+}
+
+size_t tokenizerPath(const std::string& data) {
+    TextScanner::LineTokenizer tokenizer(data);
+    TextScanner::Line line;
+    size_t tokens = 0;
+    while (tokenizer.next(line)) {
+        if (line.tokenCount == 0 || line.comment) continue;
+        tokens += line.tokenCount;
+    }
+    return tokens;
+}
+
+size_t countNewlinesPath(const std::string& data) {
+    return TextScanner::countNewlines(data.data(), data.data() + data.size());
+}
+
+// Ширина строки в символах (UTF-8)
+size_t displayWidth(const std::string& text) {
+    size_t width = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) width++;
+    }
+    return width;
+}
+
+// Лучшее время из нескольких прогонов
+double measure(const std::string& name, const std::string& data, const std::function<size_t()>& run) {
+    const int repeats = 5;
+    double best = 1e9;
+    size_t checksum = 0;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds < best) best = seconds;
+    }
+    double gbPerSecond = data.size() / best / 1e9;
+    std::cout << "   " << name << std::string(28 - std::min<size_t>(28, displayWidth(name)), ' ')
+              << std::fixed << std::setprecision(3) << std::setw(8) << gbPerSecond << " ГБ/с"
+              << "   (контроль: " << checksum << ")" << std::endl;
+    return gbPerSecond;
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    if (megabytes == 0) megabytes = 64;
+
+    std::cout << "=== БЕНЧМАРК РАЗБОРА СТРОК ===" << std::endl;
+    std::string data = generateData(megabytes * 1024 * 1024);
+    std::cout << "Объём данных: " << data.size() / (1024 * 1024) << " МБ" << std::endl;
+    std::cout << "Реализация по умолчанию: "
+              << TextScanner::backendName(TextScanner::activeBackend()) << std::endl << std::endl;
+
+    TextScanner::Backend initial = TextScanner::activeBackend();
+
+    std::cout << "1. Строки и токены:" << std::endl;
+    measure("getline + stringstream", data, [&] { return legacyStreamPath(data); });
+    measure("побайтовый string_view", data, [&] { return scalarViewPath(data); });
+
+    const TextScanner::Backend backends[] = {
+        TextScanner::Backend::Scalar, TextScanner::Backend::Sse2, TextScanner::Backend::Avx2
+    };
+    for (TextScanner::Backend backend : backends) {
+        if (!TextScanner::setBackend(backend)) {
+            std::cout << "   " << TextScanner::backendName(backend) << ": не поддерживается" << std::endl;
+            continue;
+        }
+        measure(std::string("LineTokenizer ") + TextScanner::backendName(backend), data,
+                [&] { return tokenizerPath(data); });
+    }
+
+    std::cout << std::endl << "2. Подсчёт строк (разбиение на фрагменты):" << std::endl;
+    for (TextScanner::Backend backend : backends) {
+        if (!TextScanner::setBackend(backend)) continue;
+        measure(std::string("countNewlines ") + TextScanner::backendName(backend), data,
+                [&] { return countNewlinesPath(data); });
+    }
+
+    TextScanner::setBackend(initial);
+    std::cout << std::endl << "=== БЕНЧМАРК ЗАВЕРШЕН ===" << std::endl;
+    return 0;
+}
@@ -3,10 +3,14 @@
 #include <chrono>
 #include <atomic>
 #include <vector>
+#include <algorithm>
 #include "../common/zmq_publisher.hpp"
 #include "../common/zmq_subscriber.hpp"
 #include "../common/student.hpp"
 #include "../common/serializer.hpp"
+#include "../common/student_shard.hpp"
+#include "../common/binary_serializer.hpp"
+#include "../common/payload_codec.hpp"
 
 class NetworkTest {
 private:
@@ -25,6 +29,17 @@ public:
         testSerializer();
         testPublisherSubscriber();
         testStress();
+        testDeltaUpdates();
+        testLateJoin();
+        testBackpressure();
+        testIdleSubscriber();
+        testDecodePipeline();
+        testChunkedSnapshot();
+        testShardedTopics();
+        testCompression();
+        testStalledSubscriber();
+        testSnapshotRecovery();
+        testLostChunk();
         testErrorHandling();
         
         std::cout << "=== ВСЕ ТЕСТЫ ЗАВЕРШЕНЫ ===" << std::endl;
@@ -242,12 +257,727 @@ private:
         std::cout << "  Ожидалось студентов: " << (NUM_BATCHES * STUDENTS_PER_BATCH) << std::endl;
         std::cout << "  Потеряно: " << (NUM_BATCHES * STUDENTS_PER_BATCH - students_received) << " студентов" << std::endl;
         
+        ZmqPublisher::QueueStats queue_stats = publisher.getQueueStats();
+        std::cout << "  Очередь издателя: глубина " << publisher.getQueueSize()
+                  << " из " << publisher.getQueueCapacity()
+                  << ", повторов CAS " << queue_stats.contended
+                  << ", ожиданий места " << queue_stats.fullWaits
+                  << ", засыпаний потока отправки " << queue_stats.consumerSleeps << std::endl;
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testDeltaUpdates() {
+        std::cout << "\n4. ТЕСТ ПУБЛИКАЦИИ ИЗМЕНЕНИЙ:" << std::endl;
+        
+        ZmqPublisher publisher;
+        ZmqSubscriber subscriber;
+        
+        // Без delta callback подписчик сам применяет изменения к списку
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        subscriber.setMessageCallback([&](const std::vector<Student>& students) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = students;
+        });
+        
+        publisher.start("tcp://*:5561");
+        publisher.setFormat(Serializer::Format::Binary);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        subscriber.start("tcp://localhost:5561");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        std::vector<Student> students;
+        for (int i = 0; i < 1000; ++i) {
+            students.emplace_back(i, "Name" + std::to_string(i), "LastName" + std::to_string(i),
+                                  "01.01.1990");
+        }
+        std::sort(students.begin(), students.end());
+        publisher.publishUpdate(StudentTable(students));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        
+        students[10].setId(5000);
+        students.erase(students.begin() + 20);
+        students.emplace_back(6000, "Новый", "Студент", "02.02.2000");
+        std::sort(students.begin(), students.end());
+        publisher.publishUpdate(StudentTable(students));
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        bool same = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            same = latest == students;
+        }
+        std::cout << "Снимков: " << publisher.getSnapshotsSent()
+                  << ", изменений: " << publisher.getDeltasSent()
+                  << ", применено подписчиком: " << subscriber.getDeltasReceived() << std::endl;
+        std::cout << "Список после изменения: " << (same ? "OK" : "FAIL") << std::endl;
+        
+        // Готовое изменение (как из StudentStore::takeDelta) без полного списка
+        StudentDelta changes;
+        changes.added.emplace_back(7000, "Ещё", "Студент", "03.03.2001");
+        changes.modified.push_back(students[0]);
+        changes.modified.back().setId(7001);
+        changes.removed.push_back(students[1]);
+        publisher.publishDelta(changes);
+        changes.apply(students);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            same = latest == students;
+        }
+        std::cout << "Изменений: " << publisher.getDeltasSent() << ", список после publishDelta: "
+                  << (same ? "OK" : "FAIL") << std::endl;
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testLateJoin() {
+        std::cout << "\n5. ТЕСТ ПОДКЛЮЧЕНИЯ ПОСЛЕ ПУБЛИКАЦИИ:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5562", "tcp://*:5563");
+        publisher.setFormat(Serializer::Format::Binary);
+        
+        std::vector<Student> students;
+        for (int i = 0; i < 100; ++i) {
+            students.emplace_back(i, "Name" + std::to_string(i), "LastName" + std::to_string(i),
+                                  "01.01.1990");
+        }
+        std::sort(students.begin(), students.end());
+        publisher.publishUpdate(StudentTable(students));
+        
+        // Подписчик подключается после публикации и получает снимок по запросу
+        ZmqSubscriber subscriber;
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = received;
+        });
+        
+        auto start_time = std::chrono::steady_clock::now();
+        subscriber.start("tcp://localhost:5562", "", "tcp://localhost:5563");
+        bool first_data = false;
+        for (int i = 0; i < 200 && !first_data; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            std::lock_guard<std::mutex> lock(list_mutex);
+            first_data = !latest.empty();
+        }
+        auto first_data_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        std::cout << "Первые данные через " << first_data_time.count() << " мс: "
+                  << (first_data ? "OK" : "FAIL") << std::endl;
+        
+        // Дальше подписчик продолжает по изменениям из потока без пропусков
+        for (int k = 0; k < 5; ++k) {
+            students.emplace_back(1000 + k, "Late" + std::to_string(k), "Joiner", "03.03.2003");
+            std::sort(students.begin(), students.end());
+            publisher.publishUpdate(StudentTable(students));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        
+        bool same = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            same = latest == students;
+        }
+        std::cout << "Версия подписчика: " << subscriber.getVersion()
+                  << " из " << publisher.getVersion()
+                  << ", снимков по запросу: " << publisher.getSnapshotRequests() << std::endl;
+        std::cout << "Список после изменений: " << (same ? "OK" : "FAIL") << std::endl;
+        
+        // Удаление последнего файла: пустой список доходит до подписчика
+        publisher.publishUpdate(StudentTable());
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        bool cleared = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            cleared = latest.empty() && subscriber.getStudentCount() == 0;
+        }
+        std::cout << "Пустой список после удаления: " << (cleared ? "OK" : "FAIL") << std::endl;
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testBackpressure() {
+        std::cout << "\n6. ТЕСТ КОНФЛЯЦИИ ПРИ ПЕРЕПОЛНЕНИИ:" << std::endl;
+        
+        // Маленькая очередь: обновления публикуются быстрее, чем уходят в сеть
+        ZmqPublisher publisher(4);
+        publisher.setBackpressurePolicy(ZmqPublisher::BackpressurePolicy::KeepLatest);
+        publisher.start("tcp://*:5564", "tcp://*:5565");
+        publisher.setFormat(Serializer::Format::Binary);
+        
+        ZmqSubscriber subscriber;
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = received;
+        });
+        subscriber.start("tcp://localhost:5564", "", "tcp://localhost:5565");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        std::vector<Student> students;
+        for (int i = 0; i < 5000; ++i) {
+            students.emplace_back(i, "Name" + std::to_string(i), "LastName" + std::to_string(i),
+                                  "01.01.1990");
+        }
+        std::sort(students.begin(), students.end());
+        const int UPDATES = 200;
+        for (int k = 0; k < UPDATES; ++k) {
+            students[k].setId(10000 + k);
+            publisher.publishUpdate(StudentTable(students));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        
+        // Промежуточные версии могли быть вытеснены, последняя доходит всегда
+        bool same = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            same = latest == students;
+        }
+        ZmqPublisher::QueueStats stats = publisher.getQueueStats();
+        std::cout << "Опубликовано: " << UPDATES << ", отправлено: " << publisher.getMessagesSent()
+                  << ", вытеснено: " << publisher.getMessagesDropped()
+                  << ", наибольшая глубина очереди: " << stats.highWater
+                  << " из " << publisher.getQueueCapacity() << std::endl;
+        std::cout << "Версия подписчика: " << subscriber.getVersion()
+                  << " из " << publisher.getVersion() << std::endl;
+        std::cout << "Список после конфляции: " << (same ? "OK" : "FAIL") << std::endl;
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testIdleSubscriber() {
+        std::cout << "\n7. ТЕСТ ПРОСТАИВАЮЩЕГО ПОДПИСЧИКА:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5566");
+        
+        std::atomic<bool> received(false);
+        std::chrono::steady_clock::time_point received_at;
+        ZmqSubscriber subscriber;
+        subscriber.setRawMessageCallback([&](const std::string&) {
+            received_at = std::chrono::steady_clock::now();
+            received = true;
+        });
+        subscriber.start("tcp://localhost:5566");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        
+        // Без сообщений поток приёма спит в poll и не просыпается
+        size_t wakeups_before = subscriber.getWakeups();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        size_t idle_wakeups = subscriber.getWakeups() - wakeups_before;
+        std::cout << "Пробуждений за секунду простоя: " << idle_wakeups << " "
+                  << (idle_wakeups == 0 ? "OK" : "FAIL") << std::endl;
+        
+        // Сообщение обрабатывается сразу, без интервала опроса
+        auto sent_at = std::chrono::steady_clock::now();
+        publisher.publish(std::string("ping"));
+        for (int i = 0; i < 1000 && !received; ++i) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (received) {
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(received_at - sent_at);
+            std::cout << "Задержка доставки: " << latency.count() << " мкс" << std::endl;
+        } else {
+            std::cout << "Сообщение не получено: FAIL" << std::endl;
+        }
+        
+        // Остановка будит поток через управляющий сокет
+        auto stop_start = std::chrono::steady_clock::now();
+        subscriber.stop();
+        auto stop_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - stop_start);
+        std::cout << "Остановка за " << stop_time.count() << " мс" << std::endl;
+        
+        publisher.stop();
+    }
+
+    void testDecodePipeline() {
+        std::cout << "\n8. ТЕСТ КОНВЕЙЕРА ДЕКОДИРОВАНИЯ:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5567");
+        publisher.setFormat(Serializer::Format::Binary);
+        
+        // Большие и маленькие списки вперемешку: маленькие декодируются быстрее,
+        // но выдаются всё равно в порядке отправки
+        std::mutex order_mutex;
+        std::vector<size_t> received_sizes;
+        ZmqSubscriber subscriber;
+        subscriber.setDecodeThreads(4);
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            received_sizes.push_back(received.size());
+        });
+        subscriber.start("tcp://localhost:5567");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        std::vector<Student> large;
+        for (int i = 0; i < 50000; ++i) {
+            large.emplace_back(i, "Name" + std::to_string(i), "LastName" + std::to_string(i),
+                               "01.01.1990");
+        }
+        std::vector<Student> small(large.begin(), large.begin() + 10);
+        StudentTable large_table(large);
+        StudentTable small_table(small);
+        
+        const int MESSAGES = 40;
+        std::vector<size_t> sent_sizes;
+        for (int i = 0; i < MESSAGES; ++i) {
+            const StudentTable& table = i % 4 == 0 ? large_table : small_table;
+            publisher.publish(table);
+            sent_sizes.push_back(table.size());
+        }
+        for (int i = 0; i < 100; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            std::lock_guard<std::mutex> lock(order_mutex);
+            if (received_sizes.size() == sent_sizes.size()) break;
+        }
+        
+        bool in_order = false;
+        {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            in_order = received_sizes == sent_sizes;
+        }
+        std::cout << "Порядок выдачи при " << subscriber.getDecodeThreads() << " потоках декодирования: "
+                  << (in_order ? "OK" : "FAIL") << std::endl;
+        
+        ZmqSubscriber::PipelineStats stats = subscriber.getPipelineStats();
+        auto printStage = [](const char* name, const ZmqSubscriber::StageLatency& stage) {
+            std::cout << "   " << name << ": в среднем " << static_cast<uint64_t>(stage.averageMicros())
+                      << " мкс, максимум " << stage.maxMicros << " мкс" << std::endl;
+        };
+        std::cout << "Задержки этапов (" << stats.deliver.count << " сообщений):" << std::endl;
+        printStage("ожидание декодера", stats.queued);
+        printStage("декодирование", stats.decode);
+        printStage("ожидание очереди выдачи", stats.reorder);
+        printStage("callback", stats.deliver);
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testChunkedSnapshot() {
+        std::cout << "\n9. ТЕСТ СНИМКА ЧАСТЯМИ:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.setSnapshotChunkSize(10000);
+        publisher.start("tcp://*:5568");
+        publisher.setFormat(Serializer::Format::Binary);
+        
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        ZmqSubscriber subscriber;
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = received;
+        });
+        subscriber.start("tcp://localhost:5568");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        std::vector<Student> students;
+        for (int i = 0; i < 95000; ++i) {
+            students.emplace_back(i, "Name" + std::to_string(i), "LastName" + std::to_string(i),
+                                  "01.01.1990");
+        }
+        std::sort(students.begin(), students.end());
+        publisher.publishUpdate(StudentTable(students));
+        
+        // После снимка частями цепочка изменений продолжается как обычно
+        students[5].setId(200000);
+        publisher.publishUpdate(StudentTable(students));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        
+        bool same = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            same = latest == students;
+        }
+        std::cout << "Отправлено частей: " << publisher.getSnapshotChunksSent()
+                  << ", получено: " << subscriber.getSnapshotChunksReceived()
+                  << ", изменений применено: " << subscriber.getDeltasReceived() << std::endl;
+        std::cout << "Список после сборки: " << (same ? "OK" : "FAIL") << std::endl;
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testShardedTopics() {
+        std::cout << "\n10. ТЕСТ ПУБЛИКАЦИИ ПО ТЕМАМ:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5569", "tcp://*:5570");
+        publisher.setFormat(Serializer::Format::Binary);
+        
+        std::vector<Student> students = {
+            Student(1, "Ivan", "Ivanov", "01.01.1990"),
+            Student(2, "Anna", "Ivanova", "02.02.1991"),
+            Student(3, "Petr", "Petrov", "10.10.1990"),
+            Student(4, "Oleg", "Sidorov", "05.05.1992")
+        };
+        std::sort(students.begin(), students.end());
+        StudentTable table(students);
+        publisher.publishShards(
+            StudentSharder::shard(table, StudentSharder::Mode::LastNameInitial));
+        
+        // Подписчик на одну букву получает свой шард из снимка, остальные
+        // темы отбрасывает издатель
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        ZmqSubscriber subscriber;
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = received;
+        });
+        subscriber.start("tcp://localhost:5569", "initial/I/", "tcp://localhost:5570");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        // Изменение чужой темы до подписчика не доходит
+        students[3].setId(40);
+        students[0].setId(10);
+        table = StudentTable(students);
+        publisher.publishShards(
+            StudentSharder::shard(table, StudentSharder::Mode::LastNameInitial));
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        bool own_only = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            own_only = latest.size() == 2 && latest[0].getId() == 10;
+        }
+        std::cout << "Тем у издателя: " << publisher.getTopicCount()
+                  << ", у подписчика: " << subscriber.getTopicCount()
+                  << ", версия темы: " << subscriber.getVersion("initial/I/") << std::endl;
+        std::cout << "Получен только свой шард: "
+                  << (own_only && subscriber.getTopicCount() == 1 ? "OK" : "FAIL") << std::endl;
+        subscriber.stop();
+        
+        // Темы файлов _1 и _10: подписка на первую не получает вторую ни в
+        // потоке, ни в снимке по запросу
+        std::map<std::string, StudentTable> files;
+        files[StudentSharder::fileTopic("db/student_file_1.txt")] =
+            StudentTable(std::vector<Student>{students[0]});
+        files[StudentSharder::fileTopic("db/student_file_10.txt")] =
+            StudentTable(std::vector<Student>{students[1], students[2]});
+        publisher.publishShards(files);
+        
+        std::vector<Student> file_list;
+        ZmqSubscriber file_subscriber;
+        file_subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            file_list = received;
+        });
+        file_subscriber.start("tcp://localhost:5569", StudentSharder::fileTopic("student_file_1.txt"),
+                              "tcp://localhost:5570");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        students[0].setId(100);
+        files[StudentSharder::fileTopic("db/student_file_1.txt")] =
+            StudentTable(std::vector<Student>{students[0]});
+        students[1].setId(200);
+        files[StudentSharder::fileTopic("db/student_file_10.txt")] =
+            StudentTable(std::vector<Student>{students[1], students[2]});
+        publisher.publishShards(files);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        bool exact = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            exact = file_list.size() == 1 && file_list[0].getId() == 100;
+        }
+        std::cout << "Тема file/student_file_1/ без student_file_10: "
+                  << (exact && file_subscriber.getTopicCount() == 1 ? "OK" : "FAIL") << std::endl;
+        
+        // Удалены все файлы: пустой набор тем очищает данные подписчика
+        publisher.publishShards({});
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        bool cleared = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            cleared = file_list.empty() && file_subscriber.getStudentCount() == 0;
+        }
+        std::cout << "Пустой набор тем после удаления файлов: " << (cleared ? "OK" : "FAIL") << std::endl;
+        
+        file_subscriber.stop();
+        publisher.stop();
+    }
+
+    void testCompression() {
+        std::cout << "\n11. ТЕСТ СЖАТИЯ СООБЩЕНИЙ:" << std::endl;
+        
+        if (!PayloadCodec::available()) {
+            std::cout << "Сборка без zstd, тест пропущен" << std::endl;
+            return;
+        }
+        
+        std::vector<Student> students;
+        for (int i = 0; i < 5000; ++i) {
+            students.emplace_back(i, "Name" + std::to_string(i % 50), "LastName" + std::to_string(i % 70),
+                                  "01.01.1990");
+        }
+        std::sort(students.begin(), students.end());
+        StudentTable table(students);
+        
+        std::vector<std::string> samples;
+        for (size_t begin = 0; begin < table.size(); begin += 64) {
+            samples.emplace_back();
+            BinarySerializer::serializeSnapshotChunk(table, begin, std::min(begin + 64, table.size()),
+                                                     1, 0, 1, samples.back());
+        }
+        
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5571", "tcp://*:5572");
+        publisher.setFormat(Serializer::Format::Binary);
+        publisher.setCodec(std::make_shared<const PayloadCodec>(PayloadCodec::trainDictionary(samples)));
+        publisher.publishUpdate(table);
+        
+        // Словарь подписчик получает у сервиса снимков, увидев сжатый снимок
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        ZmqSubscriber subscriber;
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = received;
+        });
+        subscriber.start("tcp://localhost:5571", "", "tcp://localhost:5572");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        students[10].setId(90000);
+        publisher.publishUpdate(StudentTable(students));
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        bool same = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            same = latest == students;
+        }
+        std::shared_ptr<const PayloadCodec> codec = subscriber.getCodec();
+        std::cout << "Сжато: " << publisher.getBytesBeforeCompression() << " -> "
+                  << publisher.getBytesAfterCompression() << " байт, получено сжатых: "
+                  << subscriber.getCompressedReceived() << std::endl;
+        std::cout << "Словарь согласован: "
+                  << (codec && codec->dictionaryId() == publisher.getCodec()->dictionaryId() ? "OK" : "FAIL")
+                  << ", список: " << (same ? "OK" : "FAIL") << std::endl;
+        
+        subscriber.stop();
+        publisher.stop();
+    }
+
+    void testStalledSubscriber() {
+        std::cout << "\n12. ТЕСТ ОСТАНОВИВШЕГОСЯ ПОДПИСЧИКА:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.setBackpressurePolicy(ZmqPublisher::BackpressurePolicy::DropOldest);
+        publisher.start("tcp://*:5573");
+        
+        // Подписчик, который никогда не читает: его sndhwm и буферы TCP заполняются
+        zmq::context_t context(1);
+        zmq::socket_t stalled(context, ZMQ_SUB);
+        stalled.set(zmq::sockopt::rcvhwm, 1);
+        stalled.set(zmq::sockopt::subscribe, "");
+        stalled.connect("tcp://localhost:5573");
+        
+        std::atomic<size_t> received(0);
+        std::atomic<bool> last_received(false);
+        std::atomic<bool> done(false);
+        std::thread reader([&] {
+            zmq::socket_t socket(context, ZMQ_SUB);
+            socket.set(zmq::sockopt::rcvtimeo, 100);
+            socket.set(zmq::sockopt::subscribe, "");
+            socket.connect("tcp://localhost:5573");
+            zmq::message_t message;
+            while (!done) {
+                if (socket.recv(message)) {
+                    received++;
+                    if (message.to_string() == "last") {
+                        last_received = true;
+                    }
+                }
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        // Больше, чем вмещает остановившийся подписчик: поток отправки не должен
+        // ждать его, и второй подписчик продолжает получать сообщения
+        const size_t MESSAGES = 4000;
+        const std::string payload(16 * 1024, 'x');
+        for (size_t i = 0; i < MESSAGES; ++i) {
+            publisher.publish(payload);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        publisher.publish(std::string("last"));
+        for (int i = 0; i < 200 && !last_received; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        done = true;
+        reader.join();
+        
+        std::cout << "Отправлено: " << publisher.getMessagesSent()
+                  << ", получено читающим подписчиком: " << received
+                  << ", вытеснено из очереди: " << publisher.getMessagesDropped() << std::endl;
+        std::cout << "Читающий подписчик получает данные: " << (last_received ? "OK" : "FAIL") << std::endl;
+        
+        stalled.close();
+        publisher.stop();
+    }
+
+    void testSnapshotRecovery() {
+        std::cout << "\n13. ТЕСТ ВОССТАНОВЛЕНИЯ СЕРВИСА СНИМКОВ:" << std::endl;
+        
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5574", "tcp://*:5575");
+        publisher.setFormat(Serializer::Format::Binary);
+        std::vector<Student> students = {
+            Student(1, "Ivan", "Ivanov", "01.01.1990"),
+            Student(2, "Petr", "Petrov", "10.10.1990")
+        };
+        publisher.publishUpdate(StudentTable(students));
+        
+        // Запрос снимка новым REQ-сокетом: число кадров ответа или 0 по таймауту
+        zmq::context_t context(1);
+        auto request = [&context]() {
+            zmq::socket_t socket(context, ZMQ_REQ);
+            socket.set(zmq::sockopt::linger, 0);
+            socket.set(zmq::sockopt::rcvtimeo, 1000);
+            socket.connect("tcp://localhost:5575");
+            socket.send(zmq::buffer(std::string("SNAPSHOT")));
+            size_t frames = 0;
+            zmq::message_t frame;
+            while (socket.recv(frame)) {
+                frames++;
+                if (!frame.more()) {
+                    break;
+                }
+            }
+            return frames;
+        };
+        
+        // Ответ обрывается ошибкой EFSM: сокет пересоздаётся, следующий запрос
+        // получает снимок (тема и тело)
+        publisher.failNextSnapshotReply();
+        size_t failed = request();
+        for (int i = 0; i < 100 && publisher.getSnapshotRestarts() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        size_t recovered = request();
+        std::cout << "Кадров до сбоя: " << failed << ", после: " << recovered
+                  << ", пересозданий: " << publisher.getSnapshotRestarts() << std::endl;
+        std::cout << "Сервис снимков восстановлен: "
+                  << (failed == 0 && recovered == 2 && publisher.getSnapshotRestarts() == 1 ? "OK" : "FAIL")
+                  << std::endl;
+        
+        // Перезапуск без сервиса снимков: сокеты и версии прошлого запуска сброшены
+        auto stop_start = std::chrono::steady_clock::now();
+        publisher.stop();
+        auto stop_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - stop_start);
+        bool restarted = publisher.start("tcp://*:5574");
+        bool reset = publisher.getTopicCount() == 0 && publisher.getVersion() == 0;
+        publisher.publishUpdate(StudentTable(students));
+        std::cout << "Остановка за " << stop_time.count() << " мс, повторный запуск: "
+                  << (restarted && reset && publisher.getVersion() == 1 ? "OK" : "FAIL") << std::endl;
+        publisher.stop();
+    }
+
+    void testLostChunk() {
+        std::cout << "\n14. ТЕСТ ПОТЕРИ ЧАСТИ СНИМКА:" << std::endl;
+        
+        // Сервис снимков знает полный список; части снимка подписчик получает
+        // от отдельного PUB-сокета теста, который пропускает одну из них
+        ZmqPublisher publisher;
+        publisher.start("tcp://*:5577", "tcp://*:5578");
+        publisher.setFormat(Serializer::Format::Binary);
+        
+        zmq::context_t context(1);
+        zmq::socket_t chunks(context, ZMQ_PUB);
+        chunks.set(zmq::sockopt::linger, 0);
+        chunks.bind("tcp://*:5576");
+        
+        std::vector<Student> students;
+        for (int i = 0; i < 300; ++i) {
+            students.emplace_back(i, "Name" + std::to_string(i), "LastName" + std::to_string(i),
+                                  "01.01.1990");
+        }
+        std::sort(students.begin(), students.end());
+        
+        // Части версии version по 100 записей, кроме части skip
+        auto sendChunks = [&](const StudentTable& table, uint64_t version, size_t skip) {
+            for (size_t index = 0; index < 3; ++index) {
+                if (index == skip) {
+                    continue;
+                }
+                std::string message;
+                BinarySerializer::serializeSnapshotChunk(table, index * 100, (index + 1) * 100,
+                                                         version, index, 3, message);
+                chunks.send(zmq::buffer(message));
+            }
+        };
+        
+        std::mutex list_mutex;
+        std::vector<Student> latest;
+        size_t partial = 0;
+        ZmqSubscriber subscriber;
+        subscriber.setMessageCallback([&](const std::vector<Student>& received) {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            latest = received;
+            if (received.size() != students.size()) {
+                partial++;
+            }
+        });
+        
+        // Подписчик подключается до первой публикации: ответ на его первый запрос снимка пуст
+        subscriber.start("tcp://localhost:5576", "", "tcp://localhost:5578");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        StudentTable first(students);
+        publisher.publishUpdate(first);
+        
+        // Пропущена средняя часть: сборка отброшена сразу, список - по запросу снимка
+        size_t requested = subscriber.getSnapshotsRequested();
+        sendChunks(first, 1, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        bool middle = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            middle = latest == students && subscriber.getVersion() == 1;
+        }
+        std::cout << "Пропущена часть 1 из 3: " << (middle ? "OK" : "FAIL")
+                  << ", запросов снимка: " << subscriber.getSnapshotsRequested() - requested << std::endl;
+        
+        // Пропущена последняя часть, дальше тема молчит: сборку прерывает срок ожидания
+        students[7].setId(5000);
+        StudentTable second(students);
+        publisher.publishUpdate(second);
+        sendChunks(second, 2, 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        bool waiting = subscriber.getVersion() == 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(list_mutex);
+            last = latest == students && subscriber.getVersion() == 2;
+        }
+        std::cout << "Пропущена часть 2 из 3: " << (waiting && last ? "OK" : "FAIL")
+                  << ", отброшено сборок: " << subscriber.getSnapshotsAbandoned()
+                  << ", неполных списков выдано: " << partial << std::endl;
+        std::cout << "Неполный снимок не выдан: "
+                  << (subscriber.getSnapshotsAbandoned() == 2 && partial == 0 ? "OK" : "FAIL") << std::endl;
+        
         subscriber.stop();
         publisher.stop();
     }
 
     void testErrorHandling() {
-        std::cout << "\n4. ТЕСТ ОБРАБОТКИ ОШИБОК:" << std::endl;
+        std::cout << "\n15. ТЕСТ ОБРАБОТКИ ОШИБОК:" << std::endl;
         
         // Тест неверного endpoint
         std::cout << "Тест неверного endpoint: ";